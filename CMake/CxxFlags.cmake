@@ -58,7 +58,7 @@ ELSE()
 # 	-Wunused-parameter (only with -Wunused or -Wall)
 # 	-Wunused-but-set-parameter (only with -Wunused or -Wall)
 
-	SET(SharedFlags "-Wno-unknown-pragmas")
+	SET(SharedFlags "-std=c++11 -Wno-unknown-pragmas")
 	
 	SET(STRICT_CXX_FLAGS "${CommonFlags} -Werror -Wall -Wextra -pedantic ${SharedFlags}")
 	SET(STRICT_CXX_FLAGS "${STRICT_CXX_FLAGS} -Wmissing-include-dirs -Wpointer-arith -Wcast-qual -Winit-self")
@@ -94,6 +94,54 @@ GLenum ConvertToGL( BufferMapMode type )
 }
 
 
+/// ----- BufferMapFlag ------
+
+const char* AsString( BufferMapFlag flag )
+{
+	switch(flag)
+	{
+		case BufferMapFlag_InvalidateRange:
+			return "InvalidateRange";
+		case BufferMapFlag_InvalidateBuffer:
+			return "InvalidateBuffer";
+		case BufferMapFlag_Unsynchronized:
+			return "Unsynchronized";
+		case BufferMapFlag_FlushExplicit:
+			return "FlushExplicit";
+	}
+	return "UnknownBufferMapFlag";
+}
+
+GLbitfield MapRangeAccessToGL( BufferMapMode mode, int flags )
+{
+	GLbitfield access = 0;
+	switch(mode)
+	{
+		case BufferMapMode_ReadOnly:
+			access = GL_MAP_READ_BIT;
+			break;
+		case BufferMapMode_WriteOnly:
+			access = GL_MAP_WRITE_BIT;
+			break;
+		case BufferMapMode_ReadWrite:
+			access = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT;
+			break;
+		default:
+			FatalError("Invalid buffer lock mode: %u", mode);
+	}
+
+	if(flags & BufferMapFlag_InvalidateRange)
+		access |= GL_MAP_INVALIDATE_RANGE_BIT;
+	if(flags & BufferMapFlag_InvalidateBuffer)
+		access |= GL_MAP_INVALIDATE_BUFFER_BIT;
+	if(flags & BufferMapFlag_Unsynchronized)
+		access |= GL_MAP_UNSYNCHRONIZED_BIT;
+	if(flags & BufferMapFlag_FlushExplicit)
+		access |= GL_MAP_FLUSH_EXPLICIT_BIT;
+	return access;
+}
+
+
 /// ----- BufferUsage ------
 
 const char* AsString( BufferUsage type )
@@ -141,6 +189,8 @@ const char* AsString( BufferTarget type )
 			return "PixelPacker";
 		case BufferTarget_PixelUnpacker:
 			return "PixelUnpacker";
+		case BufferTarget_DrawIndirect:
+			return "DrawIndirect";
 		default: ;
 	}
 	return "UnknownBufferTarget";
@@ -158,6 +208,8 @@ GLenum ConvertToGL( BufferTarget type )
 			return GL_PIXEL_PACK_BUFFER_ARB;
 		case BufferTarget_PixelUnpacker:
 			return GL_PIXEL_UNPACK_BUFFER_ARB;
+		case BufferTarget_DrawIndirect:
+			return GL_DRAW_INDIRECT_BUFFER;
 		default: ;
 	}
 	FatalError("Invalid buffer target: %u", type);
@@ -216,28 +268,24 @@ int SizeOf( IndexType type )
 /// ---- Buffer ----
 
 Buffer::Buffer( Context* context, BufferTarget target, BufferUsage usage, int count, int elementSize ) :
-    Object(context),
+    Object(context, ObjectType_Buffer),
 	m_Target(target),
 	m_Usage(usage),
 	m_Count(count),
 	m_ElementSize(elementSize),
-	m_Mapped(false)
+	m_Mapped(false),
+	m_MapStart(0),
+	m_MapCount(0),
+	m_MapFlags(0),
+	m_HasStorage(false)
 {
-	enterImmortalSection();
-
-	glGenBuffersARB(1, &m_Handle);
-
-	{
-		BufferBinding binding(context, this);
-		glBufferDataARB(ConvertToGL(m_Target), size(), NULL, ConvertToGL(m_Usage));
-	}
-
-	leaveImmortalSection();
+	// Storage is allocated on first use, see ensureStorage.
+	m_Handle = context->m_NamePool.acquire(NameKind_Buffer);
 }
 
 Buffer::~Buffer()
 {
-	glDeleteBuffersARB(1, &m_Handle);
+	// Cached vertex arrays are released with the name, see Context::forgetDeletedNames().
 }
 
 /*
@@ -260,21 +308,110 @@ BufferTarget Buffer::target() const
 void* Buffer::map( BufferMapMode type )
 {
 	assert(m_Mapped == false);
+	ensureStorage(NULL);
 
-	BufferBinding binding(context(), this);
-	void* p = glMapBufferARB(ConvertToGL(target()), ConvertToGL(type));
+	void* p = NULL;
+	if(context()->m_DirectStateAccess)
+	{
+		p = context()->gl().MapNamedBuffer(m_Handle, ConvertToGL(type));
+	}
+	else
+	{
+		GLenum editTarget = context()->bindBufferForEdit(this);
+		p = context()->gl().MapBufferARB(editTarget, ConvertToGL(type));
+	}
+	assert(p);
+
+	m_Mapped = true;
+	m_MapStart = 0;
+	m_MapCount = m_Count;
+	m_MapFlags = 0;
+	return p;
+}
+
+void* Buffer::mapRange( int start, int count, BufferMapMode mode, int flags )
+{
+	assert(m_Mapped == false);
+	assert(start >= 0 && count > 0 && start+count <= m_Count);
+	assert(flags == 0 || mode != BufferMapMode_ReadOnly);
+
+	Context* context = this->context();
+
+	if(!context->m_UseMapBufferRange)
+	{
+		if(flags & BufferMapFlag_InvalidateBuffer)
+		{
+			if(hasStorage())
+				allocateStorage(NULL);
+		}
+		char* p = (char*)map(mode);
+		m_MapStart = start;
+		m_MapCount = count;
+		return p + start*elementSize();
+	}
+
+	ensureStorage(NULL);
+
+	GLbitfield access = MapRangeAccessToGL(mode, flags);
+	void* p = NULL;
+	if(context->m_DirectStateAccess)
+	{
+		p = context->gl().MapNamedBufferRange(m_Handle, start*elementSize(), count*elementSize(), access);
+	}
+	else
+	{
+		GLenum editTarget = context->bindBufferForEdit(this);
+		p = context->gl().MapBufferRange(editTarget, start*elementSize(), count*elementSize(), access);
+	}
 	assert(p);
 
 	m_Mapped = true;
+	m_MapStart = start;
+	m_MapCount = count;
+	m_MapFlags = flags;
 	return p;
 }
 
+void Buffer::flushRange( int start, int count )
+{
+	assert(m_Mapped == true);
+
+	// Without explicit flushing, or ARB_map_buffer_range, unmap() does it.
+	if(!(m_MapFlags & BufferMapFlag_FlushExplicit))
+		return;
+
+	assert(start >= m_MapStart && start+count <= m_MapStart+m_MapCount);
+
+	context()->m_Stats.bufferBytesUploaded += count*elementSize();
+
+	GLintptr offset = (start-m_MapStart)*elementSize();
+	if(context()->m_DirectStateAccess)
+	{
+		context()->gl().FlushMappedNamedBufferRange(m_Handle, offset, count*elementSize());
+	}
+	else
+	{
+		GLenum editTarget = context()->bindBufferForEdit(this);
+		context()->gl().FlushMappedBufferRange(editTarget, offset, count*elementSize());
+	}
+}
+
 void Buffer::unmap()
 {
 	assert(m_Mapped == true);
 
-	BufferBinding binding(context(), this);
-	if(!glUnmapBufferARB( ConvertToGL(target()) ))
+	GLboolean success = GL_FALSE;
+	if(context()->m_DirectStateAccess)
+	{
+		success = context()->gl().UnmapNamedBuffer(m_Handle);
+	}
+	else
+	{
+		GLenum editTarget = context()->bindBufferForEdit(this);
+		success = context()->gl().UnmapBufferARB(editTarget);
+	}
+
+	if(!success)
 		LogWarning("glUnmapBuffer failed ...");
 
 	m_Mapped = false;
@@ -285,21 +422,74 @@ void Buffer::copyFrom( const void* source, int count, int start )
 	assert(m_Mapped == false);
 	assert(start+count <= m_Count);
 
-	BufferBinding binding(context(), this);
-	glBufferSubDataARB(ConvertToGL(target()), start*elementSize(), count*elementSize(), source);
+	context()->m_Stats.bufferBytesUploaded += count*elementSize();
+
+	// A first upload of the whole buffer allocates and fills in one call.
+	if(!m_HasStorage && start == 0 && count == m_Count)
+	{
+		ensureStorage(source);
+		SPARKPLUG_GL_CHECK_CALL_SITE(context()->gl());
+		return;
+	}
+	ensureStorage(NULL);
+
+	if(context()->m_DirectStateAccess)
+	{
+		context()->gl().NamedBufferSubData(m_Handle, start*elementSize(), count*elementSize(), source);
+	}
+	else
+	{
+		GLenum editTarget = context()->bindBufferForEdit(this);
+		context()->gl().BufferSubDataARB(editTarget, start*elementSize(), count*elementSize(), source);
+	}
 
-	CheckGl();
+	SPARKPLUG_GL_CHECK_CALL_SITE(context()->gl());
 }
 
 void Buffer::copyTo( void* destination, int count, int start )
 {
 	assert(m_Mapped == false);
 	assert(start+count <= m_Count);
+	ensureStorage(NULL);
 
-	BufferBinding binding(context(), this);
-	glGetBufferSubDataARB(ConvertToGL(target()), start*elementSize(), count*elementSize(), destination);
+	if(context()->m_DirectStateAccess)
+	{
+		context()->gl().GetNamedBufferSubData(m_Handle, start*elementSize(), count*elementSize(), destination);
+	}
+	else
+	{
+		GLenum editTarget = context()->bindBufferForEdit(this);
+		context()->gl().GetBufferSubDataARB(editTarget, start*elementSize(), count*elementSize(), destination);
+	}
+
+	SPARKPLUG_GL_CHECK_CALL_SITE(context()->gl());
+}
+
+void Buffer::ensureStorage( const void* data )
+{
+	if(m_HasStorage)
+		return;
 
-	CheckGl();
+	allocateStorage(data);
+	m_HasStorage = true;
+}
+
+bool Buffer::hasStorage() const
+{
+	return m_HasStorage;
+}
+
+void Buffer::allocateStorage( const void* data )
+{
+	if(context()->m_DirectStateAccess)
+	{
+		context()->gl().NamedBufferData(m_Handle, size(), data, ConvertToGL(m_Usage));
+	}
+	else
+	{
+		GLenum editTarget = context()->bindBufferForEdit(this);
+		context()->gl().BufferDataARB(editTarget, size(), data, ConvertToGL(m_Usage));
+	}
 }
 
 int Buffer::elementSize() const
@@ -356,6 +546,19 @@ IndexBuffer::IndexBuffer( Context* context, int count, BufferUsage usage, IndexT
 }
 
 
+/// ---- IndirectBuffer ----
+
+StrongRef<IndirectBuffer> IndirectBuffer::Create( Context* context, int count, BufferUsage usage )
+{
+	return new IndirectBuffer(context, count, usage);
+}
+
+IndirectBuffer::IndirectBuffer( Context* context, int count, BufferUsage usage ) :
+	Buffer(context, BufferTarget_DrawIndirect, usage, count, sizeof(DrawElementsIndirectCommand))
+{
+}
+
+
 /// ---- PixelBuffer ----
 
 /*
@@ -37,6 +37,19 @@ enum BufferMapMode
 const char* AsString( BufferMapMode type );
 GLenum ConvertToGL( BufferMapMode type );
 
+/**
+ * Options for Buffer::mapRange, can be combined.
+ * Only valid for writing.
+ */
+enum BufferMapFlag
+{
+	BufferMapFlag_InvalidateRange  = 1 << 0, // Previous contents of the range may be discarded
+	BufferMapFlag_InvalidateBuffer = 1 << 1, // Previous contents of the whole buffer may be discarded
+	BufferMapFlag_Unsynchronized   = 1 << 2, // Don't wait for pending operations on the buffer
+	BufferMapFlag_FlushExplicit    = 1 << 3  // Modifications are only visible after Buffer::flushRange
+};
+const char* AsString( BufferMapFlag flag );
+
 /**
  * Usage hints
  */
@@ -56,6 +69,7 @@ enum BufferTarget
 	BufferTarget_Index,
 	BufferTarget_PixelPacker,
 	BufferTarget_PixelUnpacker,
+	BufferTarget_DrawIndirect,
 	BufferTarget_Count
 };
 const char* AsString( BufferTarget type );
@@ -77,12 +91,30 @@ int SizeOf( IndexType type );
 class Buffer : public Object
 {
 public:
+	static const ObjectType PoolType = ObjectType_Buffer;
+
 	virtual ~Buffer();
 
 	bool isReady() const;
 	BufferTarget target() const;
 
 	void* map( BufferMapMode type );
+
+	/**
+	 * Maps count elements beginning at start.
+	 * flags is a combination of BufferMapFlag values.
+	 * Without ARB_map_buffer_range the whole buffer is mapped,
+	 * BufferMapFlag_InvalidateBuffer orphans its storage then.
+	 */
+	void* mapRange( int start, int count, BufferMapMode mode, int flags = 0 );
+
+	/**
+	 * Makes count modified elements beginning at start visible to OpenGL.
+	 * start is relative to the buffer, not the mapped range.
+	 * Only for ranges mapped with BufferMapFlag_FlushExplicit.
+	 */
+	void flushRange( int start, int count );
+
 	void unmap();
 
 	void copyFrom( const void* source, int count, int start = 0 );
@@ -95,12 +127,30 @@ public:
 protected:
 	Buffer( Context* context, BufferTarget target, BufferUsage usage, int count, int elementSize );
 
+	/**
+	 * Allocates the storage through allocateStorage(), unless that happened already.
+	 */
+	void ensureStorage( const void* data );
+	bool hasStorage() const;
+
+	/**
+	 * Allocates mutable storage, filled with data if it isn't NULL.
+	 * Calling it again orphans the previous storage.
+	 */
+	virtual void allocateStorage( const void* data );
+
 private:
+	friend class Context;
+
 	BufferTarget m_Target;
 	BufferUsage m_Usage;
 	int m_Count;
 	int m_ElementSize;
 	bool m_Mapped;
+	int m_MapStart; // First mapped element
+	int m_MapCount; // Mapped elements
+	int m_MapFlags; // Of the current mapRange() call
+	bool m_HasStorage;
 };
 
 
@@ -133,6 +183,28 @@ private:
 	IndexType m_IndexType;
 };
 
+/**
+ * Layout of the records glDrawElementsIndirect reads.
+ * baseInstance must be 0 without ARB_base_instance.
+ */
+struct DrawElementsIndirectCommand
+{
+	GLuint count;
+	GLuint instanceCount;
+	GLuint firstIndex;
+	GLint  baseVertex;
+	GLuint baseInstance;
+};
+
+class IndirectBuffer : public Buffer
+{
+public:
+	static StrongRef<IndirectBuffer> Create( Context* context, int count, BufferUsage usage );
+
+private:
+	IndirectBuffer( Context* context, int count, BufferUsage usage );
+};
+
 class PixelBuffer : public Buffer
 {
 public:
@@ -0,0 +1,335 @@
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/Dispatch.h>
+#include <SparkPlug/GL/Capabilities.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/// ---- Utils ----
+
+const char* AsString( Limit limit )
+{
+	switch(limit)
+	{
+		case Limit_MaxColorAttachments:
+			return "MaxColorAttachments";
+		case Limit_MaxDrawBuffers:
+			return "MaxDrawBuffers";
+		case Limit_MaxVertexTextureUnits:
+			return "MaxVertexTextureUnits";
+		case Limit_MaxFragmentTextureUnits:
+			return "MaxFragmentTextureUnits";
+		case Limit_MaxCombinedTextureUnits:
+			return "MaxCombinedTextureUnits";
+		case Limit_MaxTextureSize:
+			return "MaxTextureSize";
+		case Limit_Max3DTextureSize:
+			return "Max3DTextureSize";
+		case Limit_MaxRectangleTextureSize:
+			return "MaxRectangleTextureSize";
+		case Limit_MaxCubeMapTextureSize:
+			return "MaxCubeMapTextureSize";
+		case Limit_MaxTextureCoords:
+			return "MaxTextureCoords";
+		case Limit_MaxVertexAttributes:
+			return "MaxVertexAttributes";
+		case Limit_MaxTextureAnisotropy:
+			return "MaxTextureAnisotropy";
+		case Limit_Count:
+			;
+	}
+	return "UnknownLimit";
+}
+
+const char* AsString( Feature feature )
+{
+	switch(feature)
+	{
+		case Feature_VertexArrayObject:
+			return "VertexArrayObject";
+		case Feature_DirectStateAccess:
+			return "DirectStateAccess";
+		case Feature_CopyBuffer:
+			return "CopyBuffer";
+		case Feature_MultiBind:
+			return "MultiBind";
+		case Feature_DrawIndirect:
+			return "DrawIndirect";
+		case Feature_MultiDrawIndirect:
+			return "MultiDrawIndirect";
+		case Feature_BaseInstance:
+			return "BaseInstance";
+		case Feature_ComputeShader:
+			return "ComputeShader";
+		case Feature_Sync:
+			return "Sync";
+		case Feature_BufferStorage:
+			return "BufferStorage";
+		case Feature_MapBufferRange:
+			return "MapBufferRange";
+		case Feature_DrawInstanced:
+			return "DrawInstanced";
+		case Feature_DrawElementsBaseVertex:
+			return "DrawElementsBaseVertex";
+		case Feature_InstancedArrays:
+			return "InstancedArrays";
+		case Feature_TimerQuery:
+			return "TimerQuery";
+		case Feature_InternalFormatQuery2:
+			return "InternalFormatQuery2";
+		case Feature_DebugOutput:
+			return "DebugOutput";
+		case Feature_StringMarker:
+			return "StringMarker";
+		case Feature_TextureFilterAnisotropic:
+			return "TextureFilterAnisotropic";
+		case Feature_Count:
+			;
+	}
+	return "UnknownFeature";
+}
+
+/**
+ * Extension and the core version which includes it, if any.
+ * In the order of the Feature enum.
+ */
+const char* FeatureNames[Feature_Count][2] =
+{
+	{ "GL_ARB_vertex_array_object",        "GL_VERSION_3_0" },
+	{ "GL_ARB_direct_state_access",        "GL_VERSION_4_5" },
+	{ "GL_ARB_copy_buffer",                "GL_VERSION_3_1" },
+	{ "GL_ARB_multi_bind",                 "GL_VERSION_4_4" },
+	{ "GL_ARB_draw_indirect",              "GL_VERSION_4_0" },
+	{ "GL_ARB_multi_draw_indirect",        "GL_VERSION_4_3" },
+	{ "GL_ARB_base_instance",              "GL_VERSION_4_2" },
+	{ "GL_ARB_compute_shader",             "GL_VERSION_4_3" },
+	{ "GL_ARB_sync",                       "GL_VERSION_3_2" },
+	{ "GL_ARB_buffer_storage",             "GL_VERSION_4_4" },
+	{ "GL_ARB_map_buffer_range",           "GL_VERSION_3_0" },
+	{ "GL_ARB_draw_instanced",             "GL_VERSION_3_1" },
+	{ "GL_ARB_draw_elements_base_vertex",  "GL_VERSION_3_2" },
+	{ "GL_ARB_instanced_arrays",           "GL_VERSION_3_3" },
+	{ "GL_ARB_timer_query",                "GL_VERSION_3_3" },
+	{ "GL_ARB_internalformat_query2",      "GL_VERSION_4_3" },
+	{ "GL_ARB_debug_output",               NULL },
+	{ "GL_GREMEDY_string_marker",          NULL },
+	{ "GL_EXT_texture_filter_anisotropic", NULL }
+};
+
+GLenum ConvertToGL( Limit limit )
+{
+	switch(limit)
+	{
+		case Limit_MaxColorAttachments:
+			return GL_MAX_COLOR_ATTACHMENTS;
+		case Limit_MaxDrawBuffers:
+			return GL_MAX_DRAW_BUFFERS;
+		case Limit_MaxVertexTextureUnits:
+			return GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS;
+		case Limit_MaxFragmentTextureUnits:
+			return GL_MAX_TEXTURE_IMAGE_UNITS;
+		case Limit_MaxCombinedTextureUnits:
+			return GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS;
+		case Limit_MaxTextureSize:
+			return GL_MAX_TEXTURE_SIZE;
+		case Limit_Max3DTextureSize:
+			return GL_MAX_3D_TEXTURE_SIZE;
+		case Limit_MaxRectangleTextureSize:
+			return GL_MAX_RECTANGLE_TEXTURE_SIZE;
+		case Limit_MaxCubeMapTextureSize:
+			return GL_MAX_CUBE_MAP_TEXTURE_SIZE;
+		case Limit_MaxTextureCoords:
+			return GL_MAX_TEXTURE_COORDS;
+		case Limit_MaxVertexAttributes:
+			return GL_MAX_VERTEX_ATTRIBS;
+		case Limit_MaxTextureAnisotropy:
+			return GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT;
+		case Limit_Count:
+			;
+	}
+	FatalError("Invalid limit: %u", limit);
+	return 0;
+}
+
+unsigned long long FormatKey( TextureType type, GLenum internalFormat )
+{
+	return ((unsigned long long)type << 32) | internalFormat;
+}
+
+const char* FileHeader = "SparkPlug GL capabilities 1";
+
+
+/// ---- Capabilities ----
+
+Capabilities::Capabilities() :
+	m_Modified(false)
+{
+	for(int i = 0; i < Limit_Count; ++i)
+		m_Limits[i] = 0;
+	for(int i = 0; i < Feature_Count; ++i)
+		m_Features[i] = false;
+}
+
+std::string Capabilities::CurrentDriver( Dispatch& gl )
+{
+	const GLenum names[] = { GL_VERSION, GL_VENDOR, GL_RENDERER };
+
+	std::string driver;
+	for(int i = 0; i < 3; ++i)
+	{
+		const char* value = (const char*)gl.GetString(names[i]);
+		if(i > 0)
+			driver += " | ";
+		driver += value ? value : "";
+	}
+	return driver;
+}
+
+const std::string& Capabilities::driver() const
+{
+	return m_Driver;
+}
+
+void Capabilities::probeFeatures( Dispatch& gl )
+{
+	for(int i = 0; i < Feature_Count; ++i)
+	{
+		const char* extension = FeatureNames[i][0];
+		const char* version = FeatureNames[i][1];
+		m_Features[i] = gl.isSupported(extension) || (version && gl.isSupported(version));
+	}
+}
+
+void Capabilities::probe( Dispatch& gl )
+{
+	m_Driver = CurrentDriver(gl);
+
+	for(int i = 0; i < Limit_Count; ++i)
+	{
+		Limit limit = Limit(i);
+		if(limit == Limit_MaxTextureAnisotropy)
+		{
+			GLfloat value = 1.f;
+			if(m_Features[Feature_TextureFilterAnisotropic])
+				gl.GetFloatv(ConvertToGL(limit), &value);
+			m_Limits[i] = value;
+		}
+		else
+		{
+			GLint value = 0;
+			gl.GetIntegerv(ConvertToGL(limit), &value);
+			m_Limits[i] = value;
+		}
+	}
+
+	m_Formats.clear();
+	m_Modified = true;
+}
+
+bool Capabilities::load( const char* file, const std::string& driver )
+{
+	std::ifstream f(file);
+	if(!f.good())
+		return false;
+
+	std::string line;
+	std::getline(f, line);
+	if(line != FileHeader)
+		return false;
+
+	std::getline(f, line);
+	if(line != driver)
+		return false;
+
+	float limits[Limit_Count];
+	for(int i = 0; i < Limit_Count; ++i)
+	{
+		std::string name;
+		f >> name >> limits[i];
+		if(!f.good() || name != AsString(Limit(i)))
+			return false;
+	}
+
+	std::map<unsigned long long, bool> formats;
+	std::string tag;
+	while(f >> tag)
+	{
+		unsigned int type = 0;
+		GLenum internalFormat = 0;
+		int supported = 0;
+		f >> type >> internalFormat >> supported;
+		if(f.fail() || tag != "Format" || type >= TextureType_Count)
+			return false;
+		formats[FormatKey(TextureType(type), internalFormat)] = (supported != 0);
+	}
+
+	m_Driver = driver;
+	std::memcpy(m_Limits, limits, sizeof(m_Limits));
+	m_Formats.swap(formats);
+	m_Modified = false;
+	return true;
+}
+
+bool Capabilities::save( const char* file )
+{
+	std::ofstream f(file);
+	f << FileHeader << "\n";
+	f << m_Driver << "\n";
+
+	// Enough digits to read back the exact same floats.
+	f.precision(std::numeric_limits<float>::max_digits10);
+	for(int i = 0; i < Limit_Count; ++i)
+		f << AsString(Limit(i)) << " " << m_Limits[i] << "\n";
+
+	std::map<unsigned long long, bool>::const_iterator i = m_Formats.begin();
+	for(; i != m_Formats.end(); ++i)
+		f << "Format " << (i->first >> 32) << " " << (i->first & 0xffffffff) << " " << (int)i->second << "\n";
+
+	if(!f.good())
+	{
+		LogWarning("Can't write capabilities to '%s'", file);
+		return false;
+	}
+
+	m_Modified = false;
+	return true;
+}
+
+bool Capabilities::isModified() const
+{
+	return m_Modified;
+}
+
+float Capabilities::limit( Limit limit ) const
+{
+	assert(InsideArray(limit, Limit_Count));
+	return m_Limits[limit];
+}
+
+bool Capabilities::hasFeature( Feature feature ) const
+{
+	assert(InsideArray(feature, Feature_Count));
+	return m_Features[feature];
+}
+
+int Capabilities::formatSupport( TextureType type, GLenum internalFormat ) const
+{
+	std::map<unsigned long long, bool>::const_iterator i = m_Formats.find(FormatKey(type, internalFormat));
+	if(i == m_Formats.end())
+		return -1;
+	return i->second ? 1 : 0;
+}
+
+void Capabilities::setFormatSupport( TextureType type, GLenum internalFormat, bool supported )
+{
+	m_Formats[FormatKey(type, internalFormat)] = supported;
+	m_Modified = true;
+}
+
+}
+}
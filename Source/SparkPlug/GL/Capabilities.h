@@ -0,0 +1,131 @@
+#ifndef __SPARKPLUG_GL_CAPABILITIES__
+#define __SPARKPLUG_GL_CAPABILITIES__
+
+#include <map>
+#include <string>
+#include <SparkPlug/GL/OpenGL.h>
+#include <SparkPlug/GL/Enums.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+class Dispatch;
+
+enum Limit
+{
+	Limit_MaxColorAttachments,
+	Limit_MaxDrawBuffers,
+	Limit_MaxVertexTextureUnits,
+	Limit_MaxFragmentTextureUnits,
+	Limit_MaxCombinedTextureUnits,
+	Limit_MaxTextureSize,
+	Limit_Max3DTextureSize,
+	Limit_MaxRectangleTextureSize,
+	Limit_MaxCubeMapTextureSize,
+	Limit_MaxTextureCoords,
+	Limit_MaxVertexAttributes,
+	Limit_MaxTextureAnisotropy,
+	Limit_Count
+};
+const char* AsString( Limit limit );
+
+/**
+ * Extensions the library makes use of.
+ * Most of them are also part of some core version.
+ */
+enum Feature
+{
+	Feature_VertexArrayObject,
+	Feature_DirectStateAccess,
+	Feature_CopyBuffer,
+	Feature_MultiBind,
+	Feature_DrawIndirect,
+	Feature_MultiDrawIndirect,
+	Feature_BaseInstance,
+	Feature_ComputeShader,
+	Feature_Sync,
+	Feature_BufferStorage,
+	Feature_MapBufferRange,
+	Feature_DrawInstanced,
+	Feature_DrawElementsBaseVertex,
+	Feature_InstancedArrays,
+	Feature_TimerQuery,
+	Feature_InternalFormatQuery2,
+	Feature_DebugOutput,
+	Feature_StringMarker,
+	Feature_TextureFilterAnisotropic,
+	Feature_Count
+};
+const char* AsString( Feature feature );
+
+/**
+ * What the driver supports, as a flat table.
+ * Probing stalls the driver, so the table can be kept in a file
+ * and reused for as long as the driver stays the same.
+ *
+ * Format support is probed lazily by the textures
+ * and added to the table.
+ */
+class Capabilities
+{
+public:
+	Capabilities();
+
+	/**
+	 * Version, vendor and renderer string of the current driver.
+	 */
+	static std::string CurrentDriver( Dispatch& gl );
+
+	const std::string& driver() const;
+
+	/**
+	 * Asks the backend which features it has.
+	 * That's cheap, so it's done on every start and isn't saved.
+	 * Must come before probe().
+	 */
+	void probeFeatures( Dispatch& gl );
+
+	/**
+	 * Queries all limits of the current driver.
+	 * Known format support is forgotten.
+	 */
+	void probe( Dispatch& gl );
+
+	/**
+	 * Fails if the file is missing, unreadable
+	 * or was written for another driver.
+	 */
+	bool load( const char* file, const std::string& driver );
+	bool save( const char* file );
+
+	/**
+	 * Whether the table changed since it was loaded or saved.
+	 */
+	bool isModified() const;
+
+	float limit( Limit limit ) const;
+
+	bool hasFeature( Feature feature ) const;
+
+	/**
+	 * 1 if textures of the type can use the internal format,
+	 * 0 if they can't and -1 if it wasn't probed yet.
+	 */
+	int formatSupport( TextureType type, GLenum internalFormat ) const;
+	void setFormatSupport( TextureType type, GLenum internalFormat, bool supported );
+
+private:
+	std::string m_Driver;
+	float m_Limits[Limit_Count];
+	bool m_Features[Feature_Count];
+	std::map<unsigned long long, bool> m_Formats; // Key is type << 32 | internal format
+	bool m_Modified;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,154 @@
+#include <cstring>
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/CommandBuffer.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+CommandBuffer::CommandBuffer()
+{
+}
+
+CommandBuffer::Command& CommandBuffer::record( CommandType type, void* object )
+{
+	Command command;
+	command.type = type;
+	command.object = object;
+	command.args[0] = 0;
+	command.args[1] = 0;
+	command.args[2] = 0;
+	command.dataOffset = -1;
+	command.pointer = NULL;
+
+	m_Commands.push_back(command);
+	return m_Commands.back();
+}
+
+int CommandBuffer::storeData( const void* data, int size )
+{
+	int offset = m_Data.size();
+	m_Data.resize(offset+size);
+	if(size > 0)
+		std::memcpy(&m_Data[offset], data, size);
+	return offset;
+}
+
+int CommandBuffer::storeString( const char* string )
+{
+	return storeData(string, std::strlen(string)+1);
+}
+
+void CommandBuffer::bindTexture( int unit, Texture* texture )
+{
+	record(CommandType_BindTexture, texture).args[0] = unit;
+}
+
+void CommandBuffer::bindSampler( int unit, Sampler* sampler )
+{
+	record(CommandType_BindSampler, sampler).args[0] = unit;
+}
+
+void CommandBuffer::bindProgram( Program* program )
+{
+	record(CommandType_BindProgram, program);
+}
+
+void CommandBuffer::bindBuffer( Buffer* buffer )
+{
+	if(!buffer)
+		FatalError("Can't unbind a buffer with bindBuffer(NULL), use unbindBuffer() instead!");
+	record(CommandType_BindBuffer, buffer);
+}
+
+void CommandBuffer::unbindBuffer( BufferTarget target )
+{
+	record(CommandType_UnbindBuffer, NULL).args[0] = target;
+}
+
+void CommandBuffer::setVertexFormat( const VertexFormat& format, void* data )
+{
+	Command& command = record(CommandType_SetVertexFormat, NULL);
+	command.args[0] = m_Formats.size();
+	command.pointer = data;
+	m_Formats.push_back(format);
+}
+
+void CommandBuffer::setUniform( Program* program, const char* name, int value )
+{
+	Command& command = record(CommandType_SetUniformInt, program);
+	command.args[0] = value;
+	command.dataOffset = storeString(name);
+}
+
+void CommandBuffer::setUniform( Program* program, const char* name, float value )
+{
+	setUniform(program, name, 1, &value);
+}
+
+void CommandBuffer::setUniform( Program* program, const char* name, int length, const float* values )
+{
+	if(length < 1 || length > 4)
+		FatalError("Float uniforms have 1 to 4 components, got %d.", length);
+
+	// The name follows the values.
+	Command& command = record(CommandType_SetUniformFloats, program);
+	command.args[0] = length;
+	command.dataOffset = storeData(values, length*sizeof(float));
+	storeString(name);
+}
+
+void CommandBuffer::copyToBuffer( Buffer* buffer, const void* source, int count, int start )
+{
+	assert(start+count <= buffer->elementCount());
+
+	Command& command = record(CommandType_CopyToBuffer, buffer);
+	command.args[0] = count;
+	command.args[1] = start;
+	command.dataOffset = storeData(source, count*buffer->elementSize());
+}
+
+void CommandBuffer::draw( PrimitiveType primitive, int first, int count )
+{
+	Command& command = record(CommandType_Draw, NULL);
+	command.args[0] = primitive;
+	command.args[1] = first;
+	command.args[2] = count;
+}
+
+void CommandBuffer::drawElements( PrimitiveType primitive, int first, int count )
+{
+	Command& command = record(CommandType_DrawElements, NULL);
+	command.args[0] = primitive;
+	command.args[1] = first;
+	command.args[2] = count;
+}
+
+void CommandBuffer::dispatch( int groupsX, int groupsY, int groupsZ )
+{
+	Command& command = record(CommandType_Dispatch, NULL);
+	command.args[0] = groupsX;
+	command.args[1] = groupsY;
+	command.args[2] = groupsZ;
+}
+
+void CommandBuffer::clear()
+{
+	m_Commands.clear();
+	m_Data.clear();
+	m_Formats.clear();
+}
+
+int CommandBuffer::size() const
+{
+	return m_Commands.size();
+}
+
+bool CommandBuffer::empty() const
+{
+	return m_Commands.empty();
+}
+
+}
+}
@@ -0,0 +1,101 @@
+#ifndef __SPARKPLUG_GL_COMMAND_BUFFER__
+#define __SPARKPLUG_GL_COMMAND_BUFFER__
+
+#include <vector>
+#include <SparkPlug/GL/Enums.h>
+#include <SparkPlug/GL/Texture.h>
+#include <SparkPlug/GL/Sampler.h>
+#include <SparkPlug/GL/Shader.h>
+#include <SparkPlug/GL/Buffer.h>
+#include <SparkPlug/GL/VertexFormat.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/**
+ * Records context operations without calling OpenGL,
+ * so command buffers can be filled by any thread.
+ * The thread which owns the context replays them with Context::execute().
+ *
+ * Each command buffer must only be used by one thread at a time.
+ * Objects are referenced by raw pointers, because reference counting
+ * isn't thread safe. So they have to stay alive until the buffer was executed.
+ * Buffer data and uniform names are copied while recording.
+ */
+class CommandBuffer
+{
+public:
+	CommandBuffer();
+
+	void bindTexture( int unit, Texture* texture );
+	void bindSampler( int unit, Sampler* sampler );
+	void bindProgram( Program* program );
+	void bindBuffer( Buffer* buffer );
+	void unbindBuffer( BufferTarget target );
+	void setVertexFormat( const VertexFormat& format, void* data );
+
+	void setUniform( Program* program, const char* name, int value );
+	void setUniform( Program* program, const char* name, float value );
+	void setUniform( Program* program, const char* name, int length, const float* values );
+
+	/**
+	 * See Buffer::copyFrom()
+	 */
+	void copyToBuffer( Buffer* buffer, const void* source, int count, int start = 0 );
+
+	void draw( PrimitiveType primitive, int first, int count );
+	void drawElements( PrimitiveType primitive, int first, int count );
+	void dispatch( int groupsX, int groupsY, int groupsZ );
+
+	/**
+	 * Keeps the allocated memory, so reusing a buffer each frame is cheap.
+	 */
+	void clear();
+
+	int size() const;
+	bool empty() const;
+
+private:
+	friend class Context;
+
+	enum CommandType
+	{
+		CommandType_BindTexture,
+		CommandType_BindSampler,
+		CommandType_BindProgram,
+		CommandType_BindBuffer,
+		CommandType_UnbindBuffer,
+		CommandType_SetVertexFormat,
+		CommandType_SetUniformInt,
+		CommandType_SetUniformFloats,
+		CommandType_CopyToBuffer,
+		CommandType_Draw,
+		CommandType_DrawElements,
+		CommandType_Dispatch
+	};
+
+	struct Command
+	{
+		CommandType type;
+		void* object;
+		int   args[3];
+		int   dataOffset; // Into m_Data
+		void* pointer;
+	};
+
+	Command& record( CommandType type, void* object );
+	int storeData( const void* data, int size );
+	int storeString( const char* string );
+
+	std::vector<Command>      m_Commands;
+	std::vector<char>         m_Data; // Uniform names and values, buffer contents
+	std::vector<VertexFormat> m_Formats;
+};
+
+}
+}
+
+#endif
@@ -8,44 +8,35 @@ namespace SparkPlug
 namespace GL
 {
 
-int GetInteger( GLenum property )
+template<class T>
+GLuint HandleOf( const StrongRef<T>& object )
 {
-	int r = 0;
-	glGetIntegerv(property, &r);
-	return r;
-}
-
-float GetFloat( GLenum property )
-{
-	float r = 0.0f;
-	glGetFloatv(property, &r);
-	return r;
+	return object ? object->handle() : 0;
 }
 
 /// --- Limits ---
 Limits::Limits( Context* context ) :
 	m_Context(context)
 {
-	maxColorAttachments = GetInteger(GL_MAX_COLOR_ATTACHMENTS);
-	maxDrawBuffers      = GetInteger(GL_MAX_DRAW_BUFFERS);
+	const Capabilities& caps = context->capabilities();
 
-	maxVertexTextureUnits = GetInteger(GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS);
-	maxFragmentTextureUnits = GetInteger(GL_MAX_TEXTURE_IMAGE_UNITS);
-	maxCombinedTextureUnits = GetInteger(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS);
+	maxColorAttachments = caps.limit(Limit_MaxColorAttachments);
+	maxDrawBuffers      = caps.limit(Limit_MaxDrawBuffers);
 
-	maxTextureSize[TextureType_1D] = GetInteger(GL_MAX_TEXTURE_SIZE);
-	maxTextureSize[TextureType_2D] = GetInteger(GL_MAX_TEXTURE_SIZE);
-	maxTextureSize[TextureType_3D] = GetInteger(GL_MAX_3D_TEXTURE_SIZE);
-	maxTextureSize[TextureType_Rect] = GetInteger(GL_MAX_RECTANGLE_TEXTURE_SIZE);
-	maxTextureSize[TextureType_CubeMap] = GetInteger(GL_MAX_CUBE_MAP_TEXTURE_SIZE);
+	maxVertexTextureUnits = caps.limit(Limit_MaxVertexTextureUnits);
+	maxFragmentTextureUnits = caps.limit(Limit_MaxFragmentTextureUnits);
+	maxCombinedTextureUnits = caps.limit(Limit_MaxCombinedTextureUnits);
 
-	maxTextureCoords    = GetInteger(GL_MAX_TEXTURE_COORDS);
-	maxVertexAttributes = GetInteger(GL_MAX_VERTEX_ATTRIBS);
+	maxTextureSize[TextureType_1D] = caps.limit(Limit_MaxTextureSize);
+	maxTextureSize[TextureType_2D] = caps.limit(Limit_MaxTextureSize);
+	maxTextureSize[TextureType_3D] = caps.limit(Limit_Max3DTextureSize);
+	maxTextureSize[TextureType_Rect] = caps.limit(Limit_MaxRectangleTextureSize);
+	maxTextureSize[TextureType_CubeMap] = caps.limit(Limit_MaxCubeMapTextureSize);
 
-	if (GLEW_EXT_texture_filter_anisotropic)
-		maxTextureAnisotropy = GetFloat(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT);
-	else
-		maxTextureAnisotropy = 1.f;
+	maxTextureCoords    = caps.limit(Limit_MaxTextureCoords);
+	maxVertexAttributes = caps.limit(Limit_MaxVertexAttributes);
+
+	maxTextureAnisotropy = caps.limit(Limit_MaxTextureAnisotropy);
 
 // 	print();
 }
@@ -74,6 +65,67 @@ Context* Limits::context() const
     return m_Context;
 }
 
+/// --- Statistics ---
+Statistics::Statistics()
+{
+	reset();
+}
+
+void Statistics::reset()
+{
+	objectsDeleted = 0;
+
+	textureBindRequests = 0;
+	textureBinds = 0;
+	textureUnitEvictions = 0;
+	samplerBindRequests = 0;
+	samplerBinds = 0;
+	programBindRequests = 0;
+	programBinds = 0;
+	bufferBindRequests = 0;
+	bufferBinds = 0;
+	vertexFormatRequests = 0;
+	vertexArrayBinds = 0;
+	vertexArraysCreated = 0;
+	pipelineStateChanges = 0;
+
+	drawCalls = 0;
+	dispatchCalls = 0;
+
+	streamBufferStalls = 0;
+	gpuTimerFramesDropped = 0;
+	uniformUploads = 0;
+	bufferBytesUploaded = 0;
+	textureBytesUploaded = 0;
+}
+
+void Statistics::print() const
+{
+#define LOG_INT(var) Log("%s = %d", #var, var)
+	LOG_INT(objectsDeleted);
+	LOG_INT(textureBindRequests);
+	LOG_INT(textureBinds);
+	LOG_INT(textureUnitEvictions);
+	LOG_INT(samplerBindRequests);
+	LOG_INT(samplerBinds);
+	LOG_INT(programBindRequests);
+	LOG_INT(programBinds);
+	LOG_INT(bufferBindRequests);
+	LOG_INT(bufferBinds);
+	LOG_INT(vertexFormatRequests);
+	LOG_INT(vertexArrayBinds);
+	LOG_INT(vertexArraysCreated);
+	LOG_INT(pipelineStateChanges);
+	LOG_INT(drawCalls);
+	LOG_INT(dispatchCalls);
+	LOG_INT(streamBufferStalls);
+	LOG_INT(gpuTimerFramesDropped);
+	LOG_INT(uniformUploads);
+#undef LOG_INT
+	Log("bufferBytesUploaded = %llu", bufferBytesUploaded);
+	Log("textureBytesUploaded = %llu", textureBytesUploaded);
+}
+
 /// --- Bindings
 
 TextureBinding::TextureBinding( Context* context, int unit, const StrongRef<Texture>& texture ) :
@@ -139,30 +191,115 @@ BufferBinding::~BufferBinding()
 
 
 /// --- Context ---
-Context::Context() :
+Context::Context( Dispatch* backend ) :
+	m_OwnedBackend(backend),
+	m_Backend(backend ? backend : &m_Driver),
+	m_Dispatch(m_Backend),
+	m_DeletionQueue(this),
+	m_NamePool(this),
+	m_ShareGroup(this),
 	m_Limits(NULL),
+	m_GpuTimer(NULL),
 	m_ActiveTextureUnit(-1),
 	m_Textures(NULL),
 	m_Samplers(NULL),
+	m_VertexFormatData(NULL),
+	m_HasVertexFormat(false),
+	m_AppliedTextures(NULL),
+	m_AppliedTextureTypes(NULL),
+	m_EnabledTextureTypes(NULL),
+	m_AutoTextureUnitsFirst(0),
+	m_AutoTextureUnitsCount(0),
+	m_TextureUnitUses(NULL),
+	m_CommitCount(1),
+	m_AppliedSamplers(NULL),
+	m_AppliedProgram(0),
+	m_DirtyState(0),
+	m_DirectStateAccess(false),
+	m_UseEditBufferTarget(false),
+	m_UseMultiBind(false),
+	m_UseDrawIndirect(false),
+	m_UseMultiDrawIndirect(false),
+	m_UseComputeShader(false),
+	m_UseSync(false),
+	m_UseBufferStorage(false),
+	m_UseMapBufferRange(false),
 	m_Attributes(NULL),
-	m_ActiveAttributes(0),
-	m_Debug(false)
+	m_AttributeOffsets(NULL),
+	m_ActiveLocations(0),
+	m_AttributeBuffer(0),
+	m_AttributeData(NULL),
+	m_AttributeStride(0),
+	m_AttributeInstanceBuffer(0),
+	m_AttributeInstanceStride(0),
+	m_UseDrawInstanced(false),
+	m_UseDrawElementsBaseVertex(false),
+	m_UseInstancedArrays(false),
+	m_UseVertexArrays(false),
+	m_VertexArray(0),
+	m_VertexArrays(this),
+	m_Debug(false),
+	m_UseDebugOutput(false),
+	m_DebugLogger(NULL)
 {
+	for(int i = 0; i < DebugEventType_Count; ++i)
+		m_DebugEventCounts[i] = 0;
+
+	for(int i = 0; i < BufferTarget_Count; ++i)
+		m_AppliedBuffers[i] = 0;
+	m_DefaultIndexBuffer = 0;
+	m_EditBuffer = 0;
+
+	// Unknown until set for the first time
+	for(int i = 0; i < 4; ++i)
+	{
+		m_Viewport[i] = -1;
+		m_ScissorRect[i] = -1;
+	}
 }
 
 Context::~Context()
 {
+	// Too late to stop the logger thread here, see shutdown().
+	assert(m_DebugLogger == NULL);
+	enableDebug(false);
+
+	if(!m_CapabilityFile.empty() && m_Capabilities.isModified())
+		m_Capabilities.save(m_CapabilityFile.c_str());
+
 	if(m_Limits)
 		delete m_Limits;
 
+	if(m_GpuTimer)
+		delete m_GpuTimer;
+
 	if(m_Textures)
 		delete[] m_Textures;
 
 	if(m_Samplers)
 		delete[] m_Samplers;
 
+	if(m_AppliedTextures)
+		delete[] m_AppliedTextures;
+	m_AppliedTextures = NULL; // Remaining names are deleted after this
+
+	if(m_AppliedTextureTypes)
+		delete[] m_AppliedTextureTypes;
+
+	if(m_EnabledTextureTypes)
+		delete[] m_EnabledTextureTypes;
+
+	if(m_TextureUnitUses)
+		delete[] m_TextureUnitUses;
+
+	if(m_AppliedSamplers)
+		delete[] m_AppliedSamplers;
+
 	if(m_Attributes)
 		delete[] m_Attributes;
+
+	if(m_AttributeOffsets)
+		delete[] m_AttributeOffsets;
 }
 
 void Context::postInit()
@@ -170,13 +307,41 @@ void Context::postInit()
 	assert(!m_Limits);
 	// Must only be called once!
 
-	glewExperimental = GL_TRUE; //GL_FALSE;
-	GLenum e = glewInit();
-	if(e != GLEW_OK)
+	if(m_Backend == &m_Driver)
 	{
-		LogWarning("GLEW Error: %s", glewGetErrorString(e));
+		glewExperimental = GL_TRUE; //GL_FALSE;
+		GLenum e = glewInit();
+		if(e != GLEW_OK)
+		{
+			LogWarning("GLEW Error: %s", glewGetErrorString(e));
+		}
+		m_Driver.load();
 	}
 
+	m_Capabilities.probeFeatures(*m_Dispatch);
+	m_UseVertexArrays = m_Capabilities.hasFeature(Feature_VertexArrayObject);
+	m_DirectStateAccess = m_Capabilities.hasFeature(Feature_DirectStateAccess);
+	m_UseEditBufferTarget = m_Capabilities.hasFeature(Feature_CopyBuffer);
+	m_UseMultiBind = m_Capabilities.hasFeature(Feature_MultiBind);
+	m_UseDrawIndirect = m_Capabilities.hasFeature(Feature_DrawIndirect);
+	m_UseMultiDrawIndirect = m_Capabilities.hasFeature(Feature_MultiDrawIndirect);
+	m_UseComputeShader = m_Capabilities.hasFeature(Feature_ComputeShader);
+	m_UseSync = m_Capabilities.hasFeature(Feature_Sync);
+	m_UseBufferStorage = m_Capabilities.hasFeature(Feature_BufferStorage);
+	m_UseMapBufferRange = m_Capabilities.hasFeature(Feature_MapBufferRange);
+	m_UseDrawInstanced = m_Capabilities.hasFeature(Feature_DrawInstanced);
+	m_UseDrawElementsBaseVertex = m_Capabilities.hasFeature(Feature_DrawElementsBaseVertex);
+	m_UseInstancedArrays = m_Capabilities.hasFeature(Feature_InstancedArrays);
+	m_UseDebugOutput = m_Capabilities.hasFeature(Feature_DebugOutput);
+
+	// Probing stalls, so reuse the capabilities of the last run if the driver didn't change.
+	const std::string driver = Capabilities::CurrentDriver(*m_Dispatch);
+	if(m_CapabilityFile.empty() || !m_Capabilities.load(m_CapabilityFile.c_str(), driver))
+	{
+		m_Capabilities.probe(*m_Dispatch);
+		if(!m_CapabilityFile.empty())
+			m_Capabilities.save(m_CapabilityFile.c_str());
+	}
 	m_Limits = new Limits(this);
 
 	Log(
@@ -186,18 +351,41 @@ void Context::postInit()
 		"GLSL: %s\n"
 		"GLEW: %s\n",
 
-		glGetString(GL_VERSION),
-		glGetString(GL_VENDOR),
-		glGetString(GL_RENDERER),
-		glGetString(GL_SHADING_LANGUAGE_VERSION),
+		m_Dispatch->GetString(GL_VERSION),
+		m_Dispatch->GetString(GL_VENDOR),
+		m_Dispatch->GetString(GL_RENDERER),
+		m_Dispatch->GetString(GL_SHADING_LANGUAGE_VERSION),
 		glewGetString(GLEW_VERSION)
 	);
 
 	enableDebug(true);
 
-	m_Textures = new StrongRef<Texture>[limits().maxCombinedTextureUnits];
-	m_Samplers = new StrongRef<Sampler>[limits().maxCombinedTextureUnits];
+	int textureUnits = limits().maxCombinedTextureUnits;
+	m_Textures = new StrongRef<Texture>[textureUnits];
+	m_Samplers = new StrongRef<Sampler>[textureUnits];
+	m_AppliedTextures = new GLuint[textureUnits];
+	m_AppliedTextureTypes = new TextureType[textureUnits];
+	m_AppliedSamplers = new GLuint[textureUnits];
+	m_EnabledTextureTypes = new TextureType[textureUnits];
+	m_TextureUnitUses = new unsigned int[textureUnits];
+	for(int i = 0; i < textureUnits; ++i)
+	{
+		m_AppliedTextures[i] = 0;
+		m_AppliedTextureTypes[i] = TextureType_Count;
+		m_AppliedSamplers[i] = 0;
+		m_EnabledTextureTypes[i] = TextureType_Count;
+		m_TextureUnitUses[i] = 0;
+	}
+	m_AutoTextureUnitsCount = textureUnits;
+	m_DirtyTextures.resize(textureUnits);
+	m_DirtyTextureTypes.resize(textureUnits);
+	m_DirtySamplers.resize(textureUnits);
+
 	m_Attributes = new VertexAttribute[limits().maxVertexAttributes];
+	m_AttributeOffsets = new int[limits().maxVertexAttributes];
+
+	if(m_Capabilities.hasFeature(Feature_TimerQuery))
+		m_GpuTimer = new GpuTimer(this);
 	selectTextureUnit(0); // Cause -1 is illogical and introduces errors with some functions
 }
 
@@ -207,8 +395,143 @@ const Limits& Context::limits() const
 	return *m_Limits;
 }
 
+bool Context::sharesObjectsWith( const Context* other ) const
+{
+	return m_ShareGroup == other->m_ShareGroup;
+}
+
+void Context::shareObjectsWith( const Context* other )
+{
+	assert(!m_Limits);
+	m_ShareGroup = other->m_ShareGroup;
+}
+
+const Capabilities& Context::capabilities() const
+{
+	return m_Capabilities;
+}
+
+const ObjectPool& Context::objectPool( ObjectType type ) const
+{
+	assert(InsideArray(type, ObjectType_Count));
+	return m_ObjectPools[type];
+}
+
+void Context::setCapabilityFile( const char* file )
+{
+	assert(!m_Limits);
+	m_CapabilityFile = file ? file : "";
+}
+
+void Context::makeCurrent()
+{
+	FatalError("This context can't be made current by the library.");
+}
+
+void Context::releaseCurrent()
+{
+	FatalError("This context can't be released by the library.");
+}
+
+const Statistics& Context::stats() const
+{
+	return m_Stats;
+}
+
+void Context::resetStats()
+{
+	m_Stats.reset();
+}
+
+GpuTimer* Context::gpuTimer()
+{
+	return m_GpuTimer;
+}
+
+Dispatch& Context::gl()
+{
+	return *m_Dispatch;
+}
+
+Dispatch* Context::backend()
+{
+	return m_Backend;
+}
+
+void Context::addInterceptor( Interceptor* interceptor )
+{
+	assert(interceptor->m_Next == NULL);
+	interceptor->m_Next = m_Dispatch;
+	m_Dispatch = interceptor;
+}
+
+void Context::removeInterceptor( Interceptor* interceptor )
+{
+	if(m_Dispatch == interceptor)
+	{
+		m_Dispatch = interceptor->m_Next;
+	}
+	else
+	{
+		// Everything above the driver is an interceptor.
+		Dispatch* dispatch = m_Dispatch;
+		while(dispatch != m_Backend)
+		{
+			Interceptor* previous = static_cast<Interceptor*>(dispatch);
+			if(previous->m_Next == interceptor)
+			{
+				previous->m_Next = interceptor->m_Next;
+				break;
+			}
+			dispatch = previous->m_Next;
+		}
+
+		if(dispatch == m_Backend)
+		{
+			LogWarning("Interceptor is not part of the chain.");
+			return;
+		}
+	}
+	interceptor->m_Next = NULL;
+}
+
+void Context::endFrame()
+{
+	if(m_GpuTimer)
+		m_GpuTimer->endFrame();
+
+	m_DeletionQueue.endFrame();
+
+#if SPARKPLUG_GL_CHECK >= SPARKPLUG_GL_CHECK_FRAME
+	// Catches errors of unchecked calls, but can't tell where they happened.
+	CheckGl(*m_Dispatch, __FILE__, __LINE__);
+#endif
+}
+
 
 /// Texture ///
+
+/**
+ * Multi bind rebinds clean units inside a range too,
+ * so small gaps are cheaper than an extra call.
+ */
+const int MultiBindMaxGap = 4;
+
+/**
+ * Returns the last unit of the dirty range starting at first.
+ */
+int NextDirtyRange( const DirtyMask& mask, int first )
+{
+	int last = first;
+	for(;;)
+	{
+		int next = mask.next(last+1);
+		if(next == -1 || next-last-1 > MultiBindMaxGap)
+			return last;
+		last = next;
+	}
+}
+
 int Context::activeTextureUnit() const
 {
 	return m_ActiveTextureUnit;
@@ -219,7 +542,7 @@ void Context::selectTextureUnit( int unit )
 	if(m_ActiveTextureUnit == unit)
 		return;
 
-	glActiveTextureARB(GL_TEXTURE0_ARB+unit);
+	m_Dispatch->ActiveTextureARB(GL_TEXTURE0_ARB+unit);
 	m_ActiveTextureUnit = unit;
 }
 
@@ -227,48 +550,203 @@ void Context::bindTexture( int unit, const StrongRef<Texture>& texture )
 {
 	assert(InsideArray(unit, limits().maxCombinedTextureUnits));
 
-	if(m_Textures[unit] == texture)
-		return;
+	++m_Stats.textureBindRequests;
+	m_Textures[unit] = texture;
+	updateTextureDirty(unit);
+}
+
+const StrongRef<Texture>& Context::boundTexture( int unit ) const
+{
+	assert(InsideArray(unit, limits().maxCombinedTextureUnits));
+	return m_Textures[unit];
+}
+
+int Context::bindTextureAuto( const StrongRef<Texture>& texture )
+{
+	assert(texture);
+
+	const int first = m_AutoTextureUnitsFirst;
+	const int end   = first + m_AutoTextureUnitsCount;
+
+	int unit = -1;
+	int freeUnit = -1;
+	int leastRecentUnit = -1;
+	for(int i = first; i < end; ++i)
+	{
+		const StrongRef<Texture>& bound = m_Textures[i];
+		if(bound == texture)
+		{
+			unit = i;
+			break;
+		}
+
+		if(!bound)
+		{
+			if(freeUnit == -1)
+				freeUnit = i;
+		}
+		else if(m_TextureUnitUses[i] != m_CommitCount &&
+		        (leastRecentUnit == -1 || m_TextureUnitUses[i] < m_TextureUnitUses[leastRecentUnit]))
+		{
+			leastRecentUnit = i;
+		}
+	}
+
+	if(unit == -1)
+		unit = freeUnit;
 
+	if(unit == -1)
+	{
+		if(leastRecentUnit == -1)
+			FatalError("All %d automatic texture units are used by the next draw.", m_AutoTextureUnitsCount);
+		unit = leastRecentUnit;
+		++m_Stats.textureUnitEvictions;
+	}
+
+	m_TextureUnitUses[unit] = m_CommitCount;
+	bindTexture(unit, texture);
+	return unit;
+}
+
+void Context::setAutoTextureUnits( int first, int count )
+{
+	assert(first >= 0 && count > 0 && first+count <= limits().maxCombinedTextureUnits);
+	m_AutoTextureUnitsFirst = first;
+	m_AutoTextureUnitsCount = count;
+}
+
+void Context::updateTextureDirty( int unit )
+{
+	const StrongRef<Texture>& texture = m_Textures[unit];
+	TextureType type = texture ? texture->type() : TextureType_Count;
+	m_DirtyTextures.set(unit, m_AppliedTextures[unit] != HandleOf(texture));
+	m_DirtyTextureTypes.set(unit, m_EnabledTextureTypes[unit] != type);
+}
+
+void Context::applyTexture( int unit )
+{
+	const StrongRef<Texture>& texture = m_Textures[unit];
 	selectTextureUnit(unit);
 
 	if(!texture)
+		unbindTextureTarget(unit);
+	else
+		bindTextureName(unit, texture->type(), texture->handle());
+
+	m_DirtyTextures.set(unit, false);
+}
+
+void Context::bindTextureName( int unit, TextureType type, GLuint name )
+{
+	// A unit has a binding per target, the previous one would stay active.
+	if(m_AppliedTextureTypes[unit] != type)
+		unbindTextureTarget(unit);
+
+	m_Dispatch->BindTexture(ConvertToGL(type), name);
+	++m_Stats.textureBinds;
+	m_AppliedTextures[unit] = name;
+	m_AppliedTextureTypes[unit] = type;
+}
+
+void Context::unbindTextureTarget( int unit )
+{
+	if(m_AppliedTextureTypes[unit] == TextureType_Count)
+		return;
+
+	if(m_AppliedTextures[unit])
 	{
-		glBindTexture(ConvertToGL(m_Textures[unit]->type()), 0);
-		glDisable(ConvertToGL(m_Textures[unit]->type()));
-		m_Textures[unit] = NULL;
+		m_Dispatch->BindTexture(ConvertToGL(m_AppliedTextureTypes[unit]), 0);
+		++m_Stats.textureBinds;
 	}
-	else
+	m_AppliedTextures[unit] = 0;
+	m_AppliedTextureTypes[unit] = TextureType_Count;
+}
+
+void Context::applyTextureType( int unit )
+{
+	// Fixed function texturing needs the target to be enabled.
+	const StrongRef<Texture>& texture = m_Textures[unit];
+	TextureType type = texture ? texture->type() : TextureType_Count;
+	TextureType& enabledType = m_EnabledTextureTypes[unit];
+	if(enabledType != type)
+	{
+		selectTextureUnit(unit);
+		if(enabledType != TextureType_Count)
+			m_Dispatch->Disable(ConvertToGL(enabledType));
+		if(type != TextureType_Count)
+			m_Dispatch->Enable(ConvertToGL(type));
+		enabledType = type;
+	}
+
+	m_DirtyTextureTypes.set(unit, false);
+}
+
+void Context::commitTextures()
+{
+	if(m_UseMultiBind)
 	{
-		if(!m_Textures[unit] || (m_Textures[unit]->type() != texture->type()))
+		int first = m_DirtyTextures.next(0);
+		while(first != -1)
 		{
-			if(m_Textures[unit])
+			int last = NextDirtyRange(m_DirtyTextures, first);
+
+			m_MultiBindNames.clear();
+			for(int unit = first; unit <= last; ++unit)
 			{
-				glDisable(ConvertToGL(m_Textures[unit]->type()));
+				const StrongRef<Texture>& texture = m_Textures[unit];
+				TextureType type = texture ? texture->type() : TextureType_Count;
+
+				// Binding a texture leaves the other targets of the unit alone.
+				if(texture && m_AppliedTextures[unit] && m_AppliedTextureTypes[unit] != type)
+				{
+					m_Dispatch->BindTextures(unit, 1, NULL);
+					++m_Stats.textureBinds;
+				}
+
+				m_MultiBindNames.push_back(HandleOf(texture));
+				m_AppliedTextures[unit] = HandleOf(texture);
+				m_AppliedTextureTypes[unit] = type;
+				m_DirtyTextures.set(unit, false);
 			}
-			glEnable(ConvertToGL(texture->type()));
+			m_Dispatch->BindTextures(first, last-first+1, &m_MultiBindNames[0]);
+			m_Stats.textureBinds += last-first+1;
+
+			first = m_DirtyTextures.next(last+1);
 		}
+	}
+	else
+	{
+		for(int unit = m_DirtyTextures.next(0); unit != -1; unit = m_DirtyTextures.next(unit+1))
+			applyTexture(unit);
+	}
 
-		glBindTexture(ConvertToGL(texture->type()), texture->handle());
-		m_Textures[unit] = texture;
+	// Shaders don't care about enabled texture targets.
+	if(!m_Program)
+	{
+		for(int unit = m_DirtyTextureTypes.next(0); unit != -1; unit = m_DirtyTextureTypes.next(unit+1))
+			applyTextureType(unit);
 	}
 }
 
-const StrongRef<Texture>& Context::boundTexture( int unit ) const
+void Context::bindTextureForEdit( Texture* texture )
 {
-	assert(InsideArray(unit, limits().maxCombinedTextureUnits));
-	return m_Textures[unit];
+	int unit = m_ActiveTextureUnit;
+	if(m_AppliedTextures[unit] == texture->handle())
+		return;
+
+	bindTextureName(unit, texture->type(), texture->handle());
+	updateTextureDirty(unit);
 }
 
 
 /// Sampler ///
 void Context::bindSampler( int unit, const StrongRef<Sampler>& sampler )
 {
-	if(sampler)
-		glBindSampler(unit, sampler->handle());
-	else
-		glBindSampler(unit, 0);
+	assert(InsideArray(unit, limits().maxCombinedTextureUnits));
+
+	++m_Stats.samplerBindRequests;
 	m_Samplers[unit] = sampler;
+	m_DirtySamplers.set(unit, m_AppliedSamplers[unit] != HandleOf(sampler));
 }
 
 const StrongRef<Sampler>& Context::boundSampler( int unit ) const
@@ -277,33 +755,85 @@ const StrongRef<Sampler>& Context::boundSampler( int unit ) const
 	return m_Samplers[unit];
 }
 
-
-/// Shader ///
-void Context::bindProgram( const StrongRef<Program>& program )
+void Context::applySampler( int unit )
 {
-	if(m_Program == program)
-		return;
+	const StrongRef<Sampler>& sampler = m_Samplers[unit];
+	if(sampler)
+		m_Dispatch->BindSampler(unit, sampler->handle());
+	else
+		m_Dispatch->BindSampler(unit, 0);
+	++m_Stats.samplerBinds;
+	m_AppliedSamplers[unit] = HandleOf(sampler);
+	m_DirtySamplers.set(unit, false);
+}
+
 
-	if(!program)
+void Context::commitSamplers()
+{
+	if(m_UseMultiBind)
 	{
-		if(!m_Program)
-			return;
+		int first = m_DirtySamplers.next(0);
+		while(first != -1)
+		{
+			int last = NextDirtyRange(m_DirtySamplers, first);
+
+			m_MultiBindNames.clear();
+			for(int unit = first; unit <= last; ++unit)
+			{
+				const StrongRef<Sampler>& sampler = m_Samplers[unit];
+				m_MultiBindNames.push_back(HandleOf(sampler));
+				m_AppliedSamplers[unit] = HandleOf(sampler);
+				m_DirtySamplers.set(unit, false);
+			}
+			m_Dispatch->BindSamplers(first, last-first+1, &m_MultiBindNames[0]);
+			m_Stats.samplerBinds += last-first+1;
 
-		glUseProgram(0);
-		m_Program = NULL;
+			first = m_DirtySamplers.next(last+1);
+		}
 	}
 	else
 	{
-        glUseProgram(program->handle());
-	    m_Program = program;
+		for(int unit = m_DirtySamplers.next(0); unit != -1; unit = m_DirtySamplers.next(unit+1))
+			applySampler(unit);
 	}
 }
 
+
+/// Shader ///
+void Context::bindProgram( const StrongRef<Program>& program )
+{
+	++m_Stats.programBindRequests;
+	m_Program = program;
+	setDirty(DirtyState_Program, m_AppliedProgram != HandleOf(program));
+}
+
 const StrongRef<Program>& Context::boundProgram() const
 {
 	return m_Program;
 }
 
+void Context::applyProgram()
+{
+	if(m_Program)
+        m_Dispatch->UseProgram(m_Program->handle());
+	else
+		m_Dispatch->UseProgram(0);
+	++m_Stats.programBinds;
+	m_AppliedProgram = HandleOf(m_Program);
+	setDirty(DirtyState_Program, false);
+}
+
+void Context::bindProgramForEdit( const StrongRef<Program>& program )
+{
+	if(m_AppliedProgram == program->handle())
+		return;
+
+	m_Dispatch->UseProgram(program->handle());
+	++m_Stats.programBinds;
+	m_AppliedProgram = program->handle();
+	setDirty(DirtyState_Program, HandleOf(m_Program) != m_AppliedProgram);
+}
+
 
 /// Buffer ///
 void Context::bindBuffer( const StrongRef<Buffer>& buffer )
@@ -311,20 +841,32 @@ void Context::bindBuffer( const StrongRef<Buffer>& buffer )
 	if(!buffer)
 		FatalError("Can't unbind a buffer with bindBuffer(NULL), use unbindBuffer() instead!");
 
-	if(buffer == m_Buffers[buffer->target()])
+	++m_Stats.bufferBindRequests;
+	BufferTarget target = buffer->target();
+	if(buffer == m_Buffers[target])
 		return;
 
-	glBindBufferARB(ConvertToGL(buffer->target()), buffer->handle());
-	m_Buffers[buffer->target()] = buffer;
+	// Drawing needs storage even if nothing was uploaded yet.
+	buffer->ensureStorage(NULL);
+	m_Buffers[target] = buffer;
+	updateBufferDirty(target);
+
+	// The vertex array depends on both buffers.
+	if(target == BufferTarget_Vertex || target == BufferTarget_Index)
+		setDirty(DirtyState_VertexArray, true);
 }
 
 void Context::unbindBuffer( BufferTarget target )
 {
+	++m_Stats.bufferBindRequests;
 	if(!m_Buffers[target])
 		return;
 
-	glBindBufferARB(ConvertToGL(target), 0);
 	m_Buffers[target] = NULL;
+	updateBufferDirty(target);
+
+	if(target == BufferTarget_Vertex || target == BufferTarget_Index)
+		setDirty(DirtyState_VertexArray, true);
 }
 
 const StrongRef<Buffer>& Context::boundBuffer( BufferTarget target ) const
@@ -333,100 +875,1138 @@ const StrongRef<Buffer>& Context::boundBuffer( BufferTarget target ) const
 	return m_Buffers[target];
 }
 
+void Context::bindInstanceBuffer( const StrongRef<Buffer>& buffer )
+{
+	if(buffer && buffer->target() != BufferTarget_Vertex)
+		FatalError("Instance buffers must be vertex buffers.");
 
-void Context::setVertexFormat( const VertexFormat& format, void* data )
+	++m_Stats.bufferBindRequests;
+	if(buffer == m_InstanceBuffer)
+		return;
+
+	if(buffer)
+		buffer->ensureStorage(NULL);
+	m_InstanceBuffer = buffer;
+	if(m_VertexFormat.hasInstanceAttributes())
+		setDirty(DirtyState_VertexArray, true);
+}
+
+const StrongRef<Buffer>& Context::boundInstanceBuffer() const
 {
-	int offset = 0;
-	int formatAttributeCount = format.attributeCount();
+	return m_InstanceBuffer;
+}
 
-	for(int i = 0; i < formatAttributeCount; ++i)
-	{
-		const VertexAttribute& newAttribute = format.attribute(i);
-		//if(m_Attributes[i] != newAttribute) // TODO: GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING und so
-		{
-			m_Attributes[i] = newAttribute;
+void Context::updateBufferDirty( BufferTarget target )
+{
+	setDirty(DirtyState_FirstBuffer << target, HandleOf(m_Buffers[target]) != m_AppliedBuffers[target]);
+}
 
-			if(i >= m_ActiveAttributes)
-			{
-				// Enable ..
-				glEnableVertexAttribArray(i);
-			}
+void Context::applyBuffer( BufferTarget target )
+{
+	GLuint buffer = HandleOf(m_Buffers[target]);
 
-			// Setup ..
-			glVertexAttribPointer(
-				i, // the identifier
-				newAttribute.dataType().componentCount(), // size (i.e. how many elements of type)
-				ConvertToGL(newAttribute.dataType().primitveType()),  // type
-				newAttribute.isNormalized(),
-				format.sizeInBytes(), // stride between each element of this attribute
-				(void*)((long)data+offset) // offset from the beginning
-			);
-		}
+	// The index buffer binding is part of the vertex array state,
+	// so don't modify a cached one.
+	if(target == BufferTarget_Index && buffer != m_AppliedBuffers[target])
+		leaveVertexArray();
 
-		offset += newAttribute.dataType().sizeInBytes();
+	if(buffer != m_AppliedBuffers[target])
+	{
+		m_Dispatch->BindBufferARB(ConvertToGL(target), buffer);
+		++m_Stats.bufferBinds;
+		m_AppliedBuffers[target] = buffer;
+		if(target == BufferTarget_Index)
+			m_DefaultIndexBuffer = buffer;
 	}
+	updateBufferDirty(target);
+}
 
-	if(formatAttributeCount < m_ActiveAttributes)
+GLenum Context::bindBufferForEdit( Buffer* buffer )
+{
+	// Use a target which does not influence any other operation, if possible.
+	if(m_UseEditBufferTarget)
 	{
-		for(int i = formatAttributeCount; i < m_ActiveAttributes; ++i)
+		if(m_EditBuffer != buffer->handle())
 		{
-			// Disable ..
-			glDisableVertexAttribArray(i);
+			m_Dispatch->BindBufferARB(GL_COPY_WRITE_BUFFER, buffer->handle());
+			++m_Stats.bufferBinds;
+			m_EditBuffer = buffer->handle();
 		}
+		return GL_COPY_WRITE_BUFFER;
 	}
 
-	m_ActiveAttributes = formatAttributeCount;
-}
+	BufferTarget target = buffer->target();
+	if(target == BufferTarget_Index && buffer->handle() != m_AppliedBuffers[target])
+		leaveVertexArray();
 
+	if(m_AppliedBuffers[target] != buffer->handle())
+	{
+		m_Dispatch->BindBufferARB(ConvertToGL(target), buffer->handle());
+		++m_Stats.bufferBinds;
+		m_AppliedBuffers[target] = buffer->handle();
+		if(target == BufferTarget_Index)
+			m_DefaultIndexBuffer = buffer->handle();
+	}
+	updateBufferDirty(target);
+	return ConvertToGL(target);
+}
 
 
-/// Debugger ///
-void Context::onDebugEventWrapper(
-	GLenum source,
-	GLenum type,
-	GLuint id,
-	GLenum severity,
-	GLsizei length,
-	const char* message,
-	void* userParam
-)
+/// Vertex Format ///
+void Context::setVertexFormat( const VertexFormat& format, void* data )
 {
-	Context* context = reinterpret_cast<Context*>(userParam);
-	context->onDebugEvent(
-		DebugEventSourceFromGL(source),
-		DebugEventTypeFromGL(type),
-		id,
-		DebugEventSeverityFromGL(severity),
-		message
-	);
+	++m_Stats.vertexFormatRequests;
+	if(m_HasVertexFormat && (m_VertexFormatData == data) && (m_VertexFormat == format))
+		return;
+
+	m_VertexFormat = format;
+	m_VertexFormatData = data;
+	m_HasVertexFormat = true;
+	setDirty(DirtyState_VertexArray, true);
 }
 
-void Context::enableDebug( bool e )
+void Context::applyVertexArray()
 {
-	if(e == m_Debug)
+	const VertexFormat& format = m_VertexFormat;
+	void* data = m_VertexFormatData;
+
+	if(!m_UseVertexArrays)
+	{
+		applyBuffer(BufferTarget_Index);
+		setVertexAttributes(format, data, true);
+		setDirty(DirtyState_VertexArray, false);
 		return;
-	m_Debug = e;
+	}
 
-	if(e)
+	const StrongRef<Buffer>& vertexBuffer = m_Buffers[BufferTarget_Vertex];
+	const StrongRef<Buffer>& indexBuffer  = m_Buffers[BufferTarget_Index];
+	GLuint vertexBufferHandle = vertexBuffer ? vertexBuffer->handle() : 0;
+	GLuint indexBufferHandle  = indexBuffer  ? indexBuffer->handle()  : 0;
+
+	// The instance buffer only matters if the format reads from it.
+	GLuint instanceBufferHandle = 0;
+	if(m_InstanceBuffer && format.hasInstanceAttributes())
+		instanceBufferHandle = m_InstanceBuffer->handle();
+
+	GLuint vertexArray = m_VertexArrays.find(format, vertexBufferHandle, instanceBufferHandle, indexBufferHandle, data);
+	if(vertexArray)
 	{
-		if(GLEW_ARB_debug_output)
-		{
-			glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB);
-			glDebugMessageCallbackARB(Context::onDebugEventWrapper, this);
-			Log("ARB_debug_output supported! You may receive debug messages from your OpenGL driver.");
+		bindVertexArray(vertexArray);
+	}
+	else
+	{
+		m_Dispatch->GenVertexArrays(1, &vertexArray);
+		++m_Stats.vertexArraysCreated;
+		bindVertexArray(vertexArray);
+
+		// A new vertex array starts without index buffer and attributes.
+		if(indexBufferHandle)
+		{
+			m_Dispatch->BindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, indexBufferHandle);
+			++m_Stats.bufferBinds;
+		}
+
+		setVertexAttributes(format, data, false);
+
+		m_VertexArrays.insert(format, vertexBufferHandle, instanceBufferHandle, indexBufferHandle, data, vertexArray);
+	}
+
+	m_AppliedBuffers[BufferTarget_Index] = indexBufferHandle;
+	updateBufferDirty(BufferTarget_Index);
+	setDirty(DirtyState_VertexArray, false);
+}
+
+void Context::setVertexAttributes( const VertexFormat& format, void* data, bool diff )
+{
+	if(format.hasInstanceAttributes() && !m_UseInstancedArrays)
+		FatalError("Per instance attributes need ARB_instanced_arrays.");
+	if(format.hasInstanceAttributes() && !m_InstanceBuffer)
+		FatalError("Per instance attributes need an instance buffer, see bindInstanceBuffer().");
+
+	int formatLocationCount = format.locationCount();
+	int activeLocations = diff ? m_ActiveLocations : 0;
+
+	const StrongRef<Buffer>& vertexBuffer = m_Buffers[BufferTarget_Vertex];
+	GLuint vertexBufferHandle   = vertexBuffer ? vertexBuffer->handle() : 0;
+	GLuint instanceBufferHandle = m_InstanceBuffer ? m_InstanceBuffer->handle() : 0;
+
+	// Attribute pointers only need to be updated when they point somewhere else.
+	bool sameVertexSource =
+		diff &&
+		(m_AttributeBuffer == vertexBufferHandle) &&
+		(m_AttributeData == data) &&
+		(m_AttributeStride == format.vertexStride());
+	bool sameInstanceSource =
+		diff &&
+		(m_AttributeInstanceBuffer == instanceBufferHandle) &&
+		(m_AttributeInstanceStride == format.instanceStride());
+
+	for(int location = activeLocations; location < formatLocationCount; ++location)
+	{
+		// Enable ..
+		m_Dispatch->EnableVertexAttribArray(location);
+	}
+
+	// Pointers refer to the array buffer which is bound while setting them,
+	// so per vertex and per instance attributes are set up in separate passes.
+	for(int pass = 0; pass < 2; ++pass)
+	{
+		const bool perInstance = (pass == 1);
+		const StrongRef<Buffer>& source = perInstance ? m_InstanceBuffer : vertexBuffer;
+		const bool sameSource = perInstance ? sameInstanceSource : sameVertexSource;
+		const int stride = perInstance ? format.instanceStride() : format.vertexStride();
+		const long base = perInstance ? 0 : (long)data;
+
+		int offset = 0;
+		int location = 0;
+		for(int i = 0; i < format.attributeCount(); ++i)
+		{
+			const VertexAttribute& newAttribute = format.attribute(i);
+			const int locationCount = newAttribute.locationCount();
+
+			if(newAttribute.isPerInstance() == perInstance)
+			{
+				if(!sameSource ||
+				   (location+locationCount > activeLocations) ||
+				   (m_Attributes[location] != newAttribute) ||
+				   (m_AttributeOffsets[location] != offset))
+				{
+					bindArrayBuffer(source);
+
+					// Matrices are passed column by column.
+					const DataType& type = newAttribute.dataType();
+					const int components = type.componentCount() / locationCount;
+					const int columnSize = type.sizeInBytes() / locationCount;
+
+					for(int column = 0; column < locationCount; ++column)
+					{
+						// Setup ..
+						m_Dispatch->VertexAttribPointer(
+							location+column, // the identifier
+							components, // size (i.e. how many elements of type)
+							ConvertToGL(type.primitveType()), // type
+							newAttribute.isNormalized(),
+							stride, // stride between each element of this attribute
+							(void*)(base+offset+column*columnSize) // offset from the beginning
+						);
+
+						// New vertex arrays start with a divisor of 0.
+						if(perInstance || (diff && m_UseInstancedArrays))
+							m_Dispatch->VertexAttribDivisor(location+column, perInstance ? 1 : 0);
+					}
+
+					if(diff)
+					{
+						m_Attributes[location] = newAttribute;
+						m_AttributeOffsets[location] = offset;
+						for(int column = 1; column < locationCount; ++column)
+							m_Attributes[location+column] = VertexAttribute();
+					}
+				}
+
+				offset += newAttribute.dataType().sizeInBytes();
+			}
+
+			location += locationCount;
+		}
+	}
+
+	if(!diff)
+		return;
+
+	for(int location = formatLocationCount; location < m_ActiveLocations; ++location)
+	{
+		// Disable ..
+		m_Dispatch->DisableVertexAttribArray(location);
+	}
+
+	m_ActiveLocations = formatLocationCount;
+	m_AttributeBuffer = vertexBufferHandle;
+	m_AttributeData = data;
+	m_AttributeStride = format.vertexStride();
+	m_AttributeInstanceBuffer = instanceBufferHandle;
+	m_AttributeInstanceStride = format.instanceStride();
+}
+
+void Context::bindArrayBuffer( const StrongRef<Buffer>& buffer )
+{
+	if(m_AppliedBuffers[BufferTarget_Vertex] == HandleOf(buffer))
+		return;
+
+	m_Dispatch->BindBufferARB(GL_ARRAY_BUFFER_ARB, HandleOf(buffer));
+	++m_Stats.bufferBinds;
+	m_AppliedBuffers[BufferTarget_Vertex] = HandleOf(buffer);
+	updateBufferDirty(BufferTarget_Vertex);
+}
+
+void Context::bindVertexArray( GLuint vertexArray )
+{
+	if(m_VertexArray == vertexArray)
+		return;
+
+	m_Dispatch->BindVertexArray(vertexArray);
+	++m_Stats.vertexArrayBinds;
+	m_VertexArray = vertexArray;
+
+	if(vertexArray == 0)
+	{
+		m_AppliedBuffers[BufferTarget_Index] = m_DefaultIndexBuffer;
+		updateBufferDirty(BufferTarget_Index);
+	}
+}
+
+void Context::leaveVertexArray()
+{
+	if(m_VertexArray == 0)
+		return;
+
+	bindVertexArray(0);
+	if(m_HasVertexFormat)
+		setDirty(DirtyState_VertexArray, true);
+}
+
+void Context::releaseVertexArrays( GLuint buffer )
+{
+	if(m_VertexArrays.releaseBuffer(buffer, m_VertexArray))
+	{
+		// Deleting the bound vertex array reverts to the default one.
+		m_VertexArray = 0;
+		m_AppliedBuffers[BufferTarget_Index] = m_DefaultIndexBuffer;
+		updateBufferDirty(BufferTarget_Index);
+		setDirty(DirtyState_VertexArray, true);
+	}
+
+	if(m_AttributeBuffer == buffer)
+		m_AttributeBuffer = 0;
+	if(m_AttributeInstanceBuffer == buffer)
+		m_AttributeInstanceBuffer = 0;
+}
+
+void Context::forgetDeletedNames( ObjectType type, const std::vector<GLuint>& names )
+{
+	// Not initialized yet or being destroyed
+	if(!m_AppliedTextures)
+		return;
+
+	for(std::size_t i = 0; i < names.size(); ++i)
+	{
+		GLuint name = names[i];
+		if(type == ObjectType_Texture)
+		{
+			for(int unit = 0; unit < limits().maxCombinedTextureUnits; ++unit)
+			{
+				if(m_AppliedTextures[unit] != name)
+					continue;
+				m_AppliedTextures[unit] = 0;
+				m_AppliedTextureTypes[unit] = TextureType_Count;
+				updateTextureDirty(unit);
+			}
+		}
+		else if(type == ObjectType_Buffer)
+		{
+			for(int target = 0; target < BufferTarget_Count; ++target)
+			{
+				if(m_AppliedBuffers[target] != name)
+					continue;
+				m_AppliedBuffers[target] = 0;
+				updateBufferDirty(BufferTarget(target));
+			}
+			if(m_DefaultIndexBuffer == name)
+				m_DefaultIndexBuffer = 0;
+			if(m_EditBuffer == name)
+				m_EditBuffer = 0;
+			releaseVertexArrays(name);
+		}
+		else if(type == ObjectType_Sampler)
+		{
+			for(int unit = 0; unit < limits().maxCombinedTextureUnits; ++unit)
+			{
+				if(m_AppliedSamplers[unit] != name)
+					continue;
+				m_AppliedSamplers[unit] = 0;
+				m_DirtySamplers.set(unit, HandleOf(m_Samplers[unit]) != 0);
+			}
+		}
+		else if(type == ObjectType_Program)
+		{
+			if(m_AppliedProgram == name)
+			{
+				m_AppliedProgram = 0;
+				setDirty(DirtyState_Program, HandleOf(m_Program) != 0);
+			}
 		}
+	}
+}
+
+
+/// Commit ///
+void Context::setDirty( unsigned int state, bool dirty )
+{
+	if(dirty)
+		m_DirtyState |= state;
+	else
+		m_DirtyState &= ~state;
+}
+
+void Context::commitBindings()
+{
+	// Units requested until now may be reused by later draws.
+	++m_CommitCount;
+
+	if(m_DirtyState & DirtyState_Program)
+		applyProgram();
+
+	if(m_DirtyTextures.any() || (!m_Program && m_DirtyTextureTypes.any()))
+		commitTextures();
+
+	if(m_DirtySamplers.any())
+		commitSamplers();
+
+	if(m_HasVertexFormat && (m_DirtyState & DirtyState_VertexArray))
+		applyVertexArray();
+
+	for(int i = 0; i < BufferTarget_Count; ++i)
+	{
+		BufferTarget target = BufferTarget(i);
+
+		// Only needed to set up the vertex arrays, which did that already.
+		if(target == BufferTarget_Vertex && m_UseVertexArrays && m_HasVertexFormat)
+			continue;
+
+		if(m_DirtyState & (DirtyState_FirstBuffer << target))
+			applyBuffer(target);
+	}
+}
+
+void Context::releaseBindings()
+{
+	for(int unit = 0; unit < limits().maxCombinedTextureUnits; ++unit)
+	{
+		bindTexture(unit, NULL);
+		bindSampler(unit, NULL);
+	}
+	bindProgram(NULL);
+	for(int i = 0; i < BufferTarget_Count; ++i)
+		unbindBuffer(BufferTarget(i));
+	bindInstanceBuffer(NULL);
+
+	// Cached vertex arrays would keep the buffers alive.
+	m_HasVertexFormat = false;
+	leaveVertexArray();
+	m_VertexArrays.clear();
+
+	commitBindings();
+
+	if(m_EditBuffer)
+	{
+		m_Dispatch->BindBufferARB(GL_COPY_WRITE_BUFFER, 0);
+		++m_Stats.bufferBinds;
+		m_EditBuffer = 0;
+	}
+}
+
+GLenum IndexTypeToGL( const Buffer& indexBuffer )
+{
+	switch(indexBuffer.elementSize())
+	{
+		case 1: return GL_UNSIGNED_BYTE;
+		case 2: return GL_UNSIGNED_SHORT;
+		case 4: return GL_UNSIGNED_INT;
+	}
+	FatalError("Invalid index size: %d", indexBuffer.elementSize());
+	return 0;
+}
+
+void Context::draw( PrimitiveType primitive, int first, int count )
+{
+	commitBindings();
+	m_Dispatch->DrawArrays(ConvertToGL(primitive), first, count);
+	++m_Stats.drawCalls;
+}
+
+void Context::drawElements( PrimitiveType primitive, int first, int count )
+{
+	const StrongRef<Buffer>& indexBuffer = m_Buffers[BufferTarget_Index];
+	if(!indexBuffer)
+		FatalError("drawElements() needs an index buffer.");
+
+	commitBindings();
+	m_Dispatch->DrawElements(
+		ConvertToGL(primitive),
+		count,
+		IndexTypeToGL(*indexBuffer),
+		(void*)(long)(first*indexBuffer->elementSize())
+	);
+	++m_Stats.drawCalls;
+}
+
+void Context::drawElementsIndirect( PrimitiveType primitive, int first, int drawCount )
+{
+	const StrongRef<Buffer>& indexBuffer = m_Buffers[BufferTarget_Index];
+	if(!indexBuffer)
+		FatalError("drawElementsIndirect() needs an index buffer.");
+	if(!m_Buffers[BufferTarget_DrawIndirect])
+		FatalError("drawElementsIndirect() needs an indirect buffer.");
+
+	commitBindings();
+
+	const GLenum primitiveGL = ConvertToGL(primitive);
+	const GLenum indexTypeGL = IndexTypeToGL(*indexBuffer);
+	const int stride = sizeof(DrawElementsIndirectCommand);
+
+	if(m_UseMultiDrawIndirect)
+	{
+		m_Dispatch->MultiDrawElementsIndirect(primitiveGL, indexTypeGL, (void*)(long)(first*stride), drawCount, stride);
+		++m_Stats.drawCalls;
+	}
+	else if(m_UseDrawIndirect)
+	{
+		for(int i = 0; i < drawCount; ++i)
+			m_Dispatch->DrawElementsIndirect(primitiveGL, indexTypeGL, (void*)(long)((first+i)*stride));
+		m_Stats.drawCalls += drawCount;
+	}
+	else
+	{
+		FatalError("drawElementsIndirect() needs ARB_draw_indirect.");
+	}
+}
+
+void Context::drawInstanced( PrimitiveType primitive, int first, int count, int instanceCount )
+{
+	if(!m_UseDrawInstanced)
+		FatalError("drawInstanced() needs ARB_draw_instanced.");
+
+	commitBindings();
+	m_Dispatch->DrawArraysInstanced(ConvertToGL(primitive), first, count, instanceCount);
+	++m_Stats.drawCalls;
+}
+
+void Context::drawElementsInstanced( PrimitiveType primitive, int first, int count, int instanceCount )
+{
+	if(!m_UseDrawInstanced)
+		FatalError("drawElementsInstanced() needs ARB_draw_instanced.");
+
+	const StrongRef<Buffer>& indexBuffer = m_Buffers[BufferTarget_Index];
+	if(!indexBuffer)
+		FatalError("drawElementsInstanced() needs an index buffer.");
+
+	commitBindings();
+	m_Dispatch->DrawElementsInstanced(
+		ConvertToGL(primitive),
+		count,
+		IndexTypeToGL(*indexBuffer),
+		(void*)(long)(first*indexBuffer->elementSize()),
+		instanceCount
+	);
+	++m_Stats.drawCalls;
+}
+
+void Context::drawElementsBaseVertex( PrimitiveType primitive, int first, int count, int baseVertex, int instanceCount )
+{
+	if(!m_UseDrawElementsBaseVertex)
+		FatalError("drawElementsBaseVertex() needs ARB_draw_elements_base_vertex.");
+	if(instanceCount != 1 && !m_UseDrawInstanced)
+		FatalError("drawElementsBaseVertex() needs ARB_draw_instanced for more than one instance.");
+
+	const StrongRef<Buffer>& indexBuffer = m_Buffers[BufferTarget_Index];
+	if(!indexBuffer)
+		FatalError("drawElementsBaseVertex() needs an index buffer.");
+
+	commitBindings();
+	const GLenum primitiveGL = ConvertToGL(primitive);
+	const GLenum indexTypeGL = IndexTypeToGL(*indexBuffer);
+	void* offset = (void*)(long)(first*indexBuffer->elementSize());
+	if(instanceCount == 1)
+		m_Dispatch->DrawElementsBaseVertex(primitiveGL, count, indexTypeGL, offset, baseVertex);
+	else
+		m_Dispatch->DrawElementsInstancedBaseVertex(primitiveGL, count, indexTypeGL, offset, instanceCount, baseVertex);
+	++m_Stats.drawCalls;
+}
+
+void Context::dispatch( int groupsX, int groupsY, int groupsZ )
+{
+	if(!m_UseComputeShader)
+		FatalError("dispatch() needs ARB_compute_shader.");
+
+	commitBindings();
+	m_Dispatch->DispatchCompute(groupsX, groupsY, groupsZ);
+	++m_Stats.dispatchCalls;
+}
+
+void Context::execute( DrawList& list )
+{
+	list.sort();
+
+	// Bindings are deferred, so binding what's bound already costs nothing.
+	for(int i = 0; i < list.size(); ++i)
+	{
+		const DrawCommand& command = list.command(i);
+
+		if(!bindDrawState(command))
+			continue;
+		if(!command.indexBuffer.isNull())
+			drawElements(command.primitive, command.first, command.count);
 		else
+			draw(command.primitive, command.first, command.count);
+	}
+}
+
+bool Context::bindDrawState( const DrawCommand& command )
+{
+	if(command.vertexBuffer.isNull())
+		FatalError("DrawCommand needs a vertex buffer.");
+
+	Program* program = resolve(command.program);
+	VertexBuffer* vertexBuffer = resolve(command.vertexBuffer);
+	IndexBuffer* indexBuffer = resolve(command.indexBuffer);
+
+	// Handles don't keep objects alive, the owner of the commands has to.
+	bool stale = (!program && !command.program.isNull()) || !vertexBuffer ||
+	             (!indexBuffer && !command.indexBuffer.isNull());
+	for(int unit = 0; unit < DrawCommand::MaxTextures; ++unit)
+		if(!command.textures[unit].isNull() && !resolve(command.textures[unit]))
+			stale = true;
+	assert(!stale);
+	if(stale)
+	{
+		LogWarning("Skipping a draw command which refers to a destroyed object.");
+		return false;
+	}
+
+	bindProgram(program);
+	for(int unit = 0; unit < DrawCommand::MaxTextures; ++unit)
+		if(!command.textures[unit].isNull())
+			bindTexture(unit, resolve(command.textures[unit]));
+
+	bindBuffer(vertexBuffer);
+	setVertexFormat(vertexBuffer->format(), NULL);
+
+	if(indexBuffer)
+		bindBuffer(indexBuffer);
+	else
+		unbindBuffer(BufferTarget_Index);
+	return true;
+}
+
+void Context::execute( const CommandBuffer& commands )
+{
+	typedef CommandBuffer::Command Command;
+
+	for(int i = 0; i < commands.size(); ++i)
+	{
+		const Command& command = commands.m_Commands[i];
+		const char* data = (command.dataOffset != -1) ? &commands.m_Data[command.dataOffset] : NULL;
+
+		switch(command.type)
 		{
-			LogWarning("ARB_debug_output not supported! You won't receive any debug messages from your OpenGL driver.");
+			case CommandBuffer::CommandType_BindTexture:
+				bindTexture(command.args[0], static_cast<Texture*>(command.object));
+				break;
+
+			case CommandBuffer::CommandType_BindSampler:
+				bindSampler(command.args[0], static_cast<Sampler*>(command.object));
+				break;
+
+			case CommandBuffer::CommandType_BindProgram:
+				bindProgram(static_cast<Program*>(command.object));
+				break;
+
+			case CommandBuffer::CommandType_BindBuffer:
+				bindBuffer(static_cast<Buffer*>(command.object));
+				break;
+
+			case CommandBuffer::CommandType_UnbindBuffer:
+				unbindBuffer(BufferTarget(command.args[0]));
+				break;
+
+			case CommandBuffer::CommandType_SetVertexFormat:
+				setVertexFormat(commands.m_Formats[command.args[0]], command.pointer);
+				break;
+
+			case CommandBuffer::CommandType_SetUniformInt:
+				static_cast<Program*>(command.object)->setUniform(data, command.args[0]);
+				break;
+
+			case CommandBuffer::CommandType_SetUniformFloats:
+			{
+				float values[4];
+				int length = command.args[0];
+				if(length < 1 || length > 4) // Checked when recording, but values lives on the stack
+					FatalError("Corrupt uniform command with %d components.", length);
+				std::memcpy(values, data, length*sizeof(float));
+				static_cast<Program*>(command.object)->setUniform(data + length*sizeof(float), length, values);
+				break;
+			}
+
+			case CommandBuffer::CommandType_CopyToBuffer:
+				static_cast<Buffer*>(command.object)->copyFrom(data, command.args[0], command.args[1]);
+				break;
+
+			case CommandBuffer::CommandType_Draw:
+				draw(PrimitiveType(command.args[0]), command.args[1], command.args[2]);
+				break;
+
+			case CommandBuffer::CommandType_DrawElements:
+				drawElements(PrimitiveType(command.args[0]), command.args[1], command.args[2]);
+				break;
+
+			case CommandBuffer::CommandType_Dispatch:
+				dispatch(command.args[0], command.args[1], command.args[2]);
+				break;
 		}
 	}
+}
+
+
+
+/// Pipeline State ///
+void SetCapability( Dispatch& gl, GLenum capability, bool enabled )
+{
+	if(enabled)
+		gl.Enable(capability);
+	else
+		gl.Disable(capability);
+}
+
+void Context::setRasterState( const StrongRef<RasterState>& state )
+{
+	if(state == m_RasterState)
+		return;
+
+	++m_Stats.pipelineStateChanges;
+
+	if(state)
+		applyRasterState(state->desc());
 	else
+		applyRasterState(RasterStateDesc());
+	m_RasterState = state;
+}
+
+const StrongRef<RasterState>& Context::rasterState() const
+{
+	return m_RasterState;
+}
+
+void Context::applyRasterState( const RasterStateDesc& desc )
+{
+	RasterStateDesc& shadow = m_RasterShadow;
+
+	if(desc.cullMode != shadow.cullMode)
+	{
+		if(desc.cullMode == CullMode_None)
+		{
+			m_Dispatch->Disable(GL_CULL_FACE);
+		}
+		else
+		{
+			if(shadow.cullMode == CullMode_None)
+				m_Dispatch->Enable(GL_CULL_FACE);
+			m_Dispatch->CullFace(ConvertToGL(desc.cullMode));
+		}
+	}
+
+	if(desc.fillMode != shadow.fillMode)
+		m_Dispatch->PolygonMode(GL_FRONT_AND_BACK, ConvertToGL(desc.fillMode));
+
+	if(desc.frontCounterClockwise != shadow.frontCounterClockwise)
+		m_Dispatch->FrontFace(desc.frontCounterClockwise ? GL_CCW : GL_CW);
+
+	if(desc.scissorTest != shadow.scissorTest)
+		SetCapability(*m_Dispatch, GL_SCISSOR_TEST, desc.scissorTest);
+
+	if(desc.polygonOffset != shadow.polygonOffset)
+		SetCapability(*m_Dispatch, GL_POLYGON_OFFSET_FILL, desc.polygonOffset);
+
+	if(desc.polygonOffset &&
+	   ((desc.polygonOffsetFactor != shadow.polygonOffsetFactor) ||
+	    (desc.polygonOffsetUnits  != shadow.polygonOffsetUnits)))
+	{
+		m_Dispatch->PolygonOffset(desc.polygonOffsetFactor, desc.polygonOffsetUnits);
+		shadow.polygonOffsetFactor = desc.polygonOffsetFactor;
+		shadow.polygonOffsetUnits  = desc.polygonOffsetUnits;
+	}
+
+	// The offset values are left alone while disabled,
+	// so only copy what has actually been applied.
+	float polygonOffsetFactor = shadow.polygonOffsetFactor;
+	float polygonOffsetUnits  = shadow.polygonOffsetUnits;
+	shadow = desc;
+	shadow.polygonOffsetFactor = polygonOffsetFactor;
+	shadow.polygonOffsetUnits  = polygonOffsetUnits;
+}
+
+void Context::setBlendState( const StrongRef<BlendState>& state )
+{
+	if(state == m_BlendState)
+		return;
+
+	++m_Stats.pipelineStateChanges;
+
+	if(state)
+		applyBlendState(state->desc());
+	else
+		applyBlendState(BlendStateDesc());
+	m_BlendState = state;
+}
+
+const StrongRef<BlendState>& Context::blendState() const
+{
+	return m_BlendState;
+}
+
+void Context::applyBlendState( const BlendStateDesc& desc )
+{
+	BlendStateDesc& shadow = m_BlendShadow;
+
+	if(desc.blend != shadow.blend)
+		SetCapability(*m_Dispatch, GL_BLEND, desc.blend);
+
+	// Blend functions are left alone while blending is disabled.
+	if(desc.blend)
+	{
+		if((desc.sourceColor != shadow.sourceColor) ||
+		   (desc.destinationColor != shadow.destinationColor) ||
+		   (desc.sourceAlpha != shadow.sourceAlpha) ||
+		   (desc.destinationAlpha != shadow.destinationAlpha))
+		{
+			m_Dispatch->BlendFuncSeparate(
+				ConvertToGL(desc.sourceColor),
+				ConvertToGL(desc.destinationColor),
+				ConvertToGL(desc.sourceAlpha),
+				ConvertToGL(desc.destinationAlpha)
+			);
+			shadow.sourceColor      = desc.sourceColor;
+			shadow.destinationColor = desc.destinationColor;
+			shadow.sourceAlpha      = desc.sourceAlpha;
+			shadow.destinationAlpha = desc.destinationAlpha;
+		}
+
+		if((desc.colorOperation != shadow.colorOperation) ||
+		   (desc.alphaOperation != shadow.alphaOperation))
+		{
+			m_Dispatch->BlendEquationSeparate(
+				ConvertToGL(desc.colorOperation),
+				ConvertToGL(desc.alphaOperation)
+			);
+			shadow.colorOperation = desc.colorOperation;
+			shadow.alphaOperation = desc.alphaOperation;
+		}
+	}
+
+	if((desc.writeRed != shadow.writeRed) ||
+	   (desc.writeGreen != shadow.writeGreen) ||
+	   (desc.writeBlue != shadow.writeBlue) ||
+	   (desc.writeAlpha != shadow.writeAlpha))
+	{
+		m_Dispatch->ColorMask(desc.writeRed, desc.writeGreen, desc.writeBlue, desc.writeAlpha);
+		shadow.writeRed   = desc.writeRed;
+		shadow.writeGreen = desc.writeGreen;
+		shadow.writeBlue  = desc.writeBlue;
+		shadow.writeAlpha = desc.writeAlpha;
+	}
+
+	shadow.blend = desc.blend;
+}
+
+void Context::setDepthStencilState( const StrongRef<DepthStencilState>& state )
+{
+	if(state == m_DepthStencilState)
+		return;
+
+	++m_Stats.pipelineStateChanges;
+
+	if(state)
+		applyDepthStencilState(state->desc());
+	else
+		applyDepthStencilState(DepthStencilStateDesc());
+	m_DepthStencilState = state;
+}
+
+const StrongRef<DepthStencilState>& Context::depthStencilState() const
+{
+	return m_DepthStencilState;
+}
+
+void Context::applyDepthStencilState( const DepthStencilStateDesc& desc )
+{
+	DepthStencilStateDesc& shadow = m_DepthStencilShadow;
+
+	if(desc.depthTest != shadow.depthTest)
+		SetCapability(*m_Dispatch, GL_DEPTH_TEST, desc.depthTest);
+
+	if(desc.depthWrite != shadow.depthWrite)
+	{
+		m_Dispatch->DepthMask(desc.depthWrite);
+		shadow.depthWrite = desc.depthWrite;
+	}
+
+	if(desc.depthTest)
+	{
+		if(desc.depthFunction != shadow.depthFunction)
+		{
+			m_Dispatch->DepthFunc(ConvertToGL(desc.depthFunction));
+			shadow.depthFunction = desc.depthFunction;
+		}
+	}
+
+	if(desc.stencilTest != shadow.stencilTest)
+		SetCapability(*m_Dispatch, GL_STENCIL_TEST, desc.stencilTest);
+
+	if(desc.stencilWriteMask != shadow.stencilWriteMask)
+	{
+		m_Dispatch->StencilMask(desc.stencilWriteMask);
+		shadow.stencilWriteMask = desc.stencilWriteMask;
+	}
+
+	if(desc.stencilTest)
 	{
-		if(GLEW_ARB_debug_output)
+		if((desc.stencilFunction != shadow.stencilFunction) ||
+		   (desc.stencilReference != shadow.stencilReference) ||
+		   (desc.stencilReadMask != shadow.stencilReadMask))
+		{
+			m_Dispatch->StencilFunc(ConvertToGL(desc.stencilFunction), desc.stencilReference, desc.stencilReadMask);
+			shadow.stencilFunction  = desc.stencilFunction;
+			shadow.stencilReference = desc.stencilReference;
+			shadow.stencilReadMask  = desc.stencilReadMask;
+		}
+
+		if((desc.stencilFail != shadow.stencilFail) ||
+		   (desc.stencilDepthFail != shadow.stencilDepthFail) ||
+		   (desc.stencilPass != shadow.stencilPass))
 		{
-			glDebugMessageCallbackARB(NULL, NULL);
+			m_Dispatch->StencilOp(
+				ConvertToGL(desc.stencilFail),
+				ConvertToGL(desc.stencilDepthFail),
+				ConvertToGL(desc.stencilPass)
+			);
+			shadow.stencilFail      = desc.stencilFail;
+			shadow.stencilDepthFail = desc.stencilDepthFail;
+			shadow.stencilPass      = desc.stencilPass;
 		}
 	}
+
+	shadow.depthTest   = desc.depthTest;
+	shadow.stencilTest = desc.stencilTest;
+}
+
+void Context::setViewport( int x, int y, int width, int height )
+{
+	if((m_Viewport[0] == x) &&
+	   (m_Viewport[1] == y) &&
+	   (m_Viewport[2] == width) &&
+	   (m_Viewport[3] == height))
+		return;
+
+	m_Dispatch->Viewport(x, y, width, height);
+	m_Viewport[0] = x;
+	m_Viewport[1] = y;
+	m_Viewport[2] = width;
+	m_Viewport[3] = height;
+}
+
+void Context::setScissorRect( int x, int y, int width, int height )
+{
+	if((m_ScissorRect[0] == x) &&
+	   (m_ScissorRect[1] == y) &&
+	   (m_ScissorRect[2] == width) &&
+	   (m_ScissorRect[3] == height))
+		return;
+
+	m_Dispatch->Scissor(x, y, width, height);
+	m_ScissorRect[0] = x;
+	m_ScissorRect[1] = y;
+	m_ScissorRect[2] = width;
+	m_ScissorRect[3] = height;
+}
+
+
+
+/// Debugger ///
+/**
+ * Events which were delivered that often within the window are suppressed
+ * until the next window starts, so an error which comes back later is shown again.
+ */
+const int DebugEventRepeatLimit = 5;
+const std::chrono::seconds DebugEventRepeatWindow(1);
+
+void Context::onDebugEventWrapper(
+	GLenum source,
+	GLenum type,
+	GLuint id,
+	GLenum severity,
+	GLsizei length,
+	const char* message,
+	void* userParam
+)
+{
+	Context* context = reinterpret_cast<Context*>(userParam);
+	DebugEventType eventType = DebugEventTypeFromGL(type);
+	++context->m_DebugEventCounts[eventType];
+
+	if(context->m_DebugLogger)
+	{
+		context->m_DebugLogger->push(
+			DebugEventSourceFromGL(source),
+			eventType,
+			id,
+			DebugEventSeverityFromGL(severity),
+			message,
+			length
+		);
+	}
+	else
+	{
+		context->deliverDebugEvent(
+			DebugEventSourceFromGL(source),
+			eventType,
+			id,
+			DebugEventSeverityFromGL(severity),
+			message
+		);
+	}
+}
+
+void Context::deliverDebugEvent(
+	DebugEventSource source,
+	DebugEventType type,
+	int id,
+	DebugEventSeverity severity,
+	const char* message
+)
+{
+	unsigned long long key =
+		((unsigned long long)(unsigned int)id << 16) |
+		((unsigned long long)source << 8) |
+		(unsigned long long)type;
+
+	DebugEventRepeats& repeats = m_DebugEventRepeats[key];
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if(now - repeats.windowStart >= DebugEventRepeatWindow)
+	{
+		if(repeats.count > DebugEventRepeatLimit)
+			Log("OpenGL Debug Event #%i was suppressed %d times.", id, repeats.count-DebugEventRepeatLimit);
+		repeats.windowStart = now;
+		repeats.count = 0;
+	}
+
+	++repeats.count;
+	if(repeats.count <= DebugEventRepeatLimit)
+		onDebugEvent(source, type, id, severity, message);
+
+	if(repeats.count == DebugEventRepeatLimit)
+		Log("OpenGL Debug Event #%i occurred %d times within a second, suppressing repeats for now.", id, repeats.count);
+}
+
+void Context::shutdown()
+{
+	enableDebug(false);
+
+	// postInit() didn't run
+	if(!m_Limits)
+		return;
+
+	// Dropping the bindings may destroy objects, so deletions are flushed afterwards.
+	releaseBindings();
+
+	if(m_GpuTimer)
+	{
+		delete m_GpuTimer;
+		m_GpuTimer = NULL;
+	}
+
+	m_DeletionQueue.flush();
+	m_NamePool.release();
+}
+
+void Context::enableDebug( bool e, bool asynchronous )
+{
+	if(e == m_Debug && (!e || asynchronous == (m_DebugLogger != NULL)))
+		return;
+
+	if(m_UseDebugOutput)
+	{
+		// Detach first, so no events arrive while switching.
+		m_Dispatch->DebugMessageCallbackARB(NULL, NULL);
+		if(m_DebugLogger)
+		{
+			delete m_DebugLogger;
+			m_DebugLogger = NULL;
+		}
+	}
+
+	bool wasEnabled = m_Debug;
+	m_Debug = e;
+
+	if(e)
+	{
+		if(m_UseDebugOutput)
+		{
+			if(asynchronous)
+			{
+				m_DebugLogger = new DebugLogger(this);
+				m_Dispatch->Disable(GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB);
+			}
+			else
+			{
+				m_Dispatch->Enable(GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB);
+			}
+			m_Dispatch->DebugMessageCallbackARB(Context::onDebugEventWrapper, this);
+
+			if(!wasEnabled)
+				Log("ARB_debug_output supported! You may receive debug messages from your OpenGL driver.");
+		}
+		else
+		{
+			LogWarning("ARB_debug_output not supported! You won't receive any debug messages from your OpenGL driver.");
+		}
+	}
+}
+
+void Context::setDebugSourceEnabled( DebugEventSource source, bool enabled )
+{
+	if(m_UseDebugOutput)
+		m_Dispatch->DebugMessageControlARB(ConvertToGL(source), GL_DONT_CARE, GL_DONT_CARE, 0, NULL, enabled);
+}
+
+void Context::setDebugTypeEnabled( DebugEventType type, bool enabled )
+{
+	if(m_UseDebugOutput)
+		m_Dispatch->DebugMessageControlARB(GL_DONT_CARE, ConvertToGL(type), GL_DONT_CARE, 0, NULL, enabled);
+}
+
+void Context::setDebugSeverityEnabled( DebugEventSeverity severity, bool enabled )
+{
+	if(m_UseDebugOutput)
+		m_Dispatch->DebugMessageControlARB(GL_DONT_CARE, GL_DONT_CARE, ConvertToGL(severity), 0, NULL, enabled);
+}
+
+void Context::setDebugEventEnabled( DebugEventSource source, DebugEventType type, int id, bool enabled )
+{
+	if(m_UseDebugOutput)
+	{
+		GLuint idGL = id;
+		m_Dispatch->DebugMessageControlARB(ConvertToGL(source), ConvertToGL(type), GL_DONT_CARE, 1, &idGL, enabled);
+	}
+}
+
+void Context::debugMark( const char* message )
+{
+	if(m_Capabilities.hasFeature(Feature_StringMarker))
+		m_Dispatch->StringMarkerGREMEDY(0, message);
+}
+
+int Context::debugEventCount( DebugEventType type ) const
+{
+	assert(InsideArray(type, DebugEventType_Count));
+	return m_DebugEventCounts[type];
+}
+
+int Context::droppedDebugEvents() const
+{
+	if(m_DebugLogger)
+		return m_DebugLogger->droppedEvents();
+	else
+		return 0;
 }
 
 void Context::emitDebugMessage(
@@ -439,7 +2019,7 @@ void Context::emitDebugMessage(
 {
 	FatalError("emitDebugMessage() does not work properly.");
 
-	glDebugMessageInsertARB(
+	m_Dispatch->DebugMessageInsertARB(
 		ConvertToGL(source),
 		ConvertToGL(type),
 		id,
@@ -1,14 +1,30 @@
 #ifndef __SPARKPLUG_RENDER_CONTEXT__
 #define __SPARKPLUG_RENDER_CONTEXT__
 
+#include <map>
 #include <vector>
 #include <stack>
+#include <atomic>
+#include <memory>
+#include <chrono>
 #include <SparkPlug/Reference.h>
 #include <SparkPlug/GL/OpenGL.h>
+#include <SparkPlug/GL/Dispatch.h>
+#include <SparkPlug/GL/Capabilities.h>
 #include <SparkPlug/GL/Texture.h>
 #include <SparkPlug/GL/Sampler.h>
 #include <SparkPlug/GL/Shader.h>
 #include <SparkPlug/GL/Buffer.h>
+#include <SparkPlug/GL/StreamBuffer.h>
+#include <SparkPlug/GL/VertexArray.h>
+#include <SparkPlug/GL/DirtyMask.h>
+#include <SparkPlug/GL/PipelineState.h>
+#include <SparkPlug/GL/DrawList.h>
+#include <SparkPlug/GL/CommandBuffer.h>
+#include <SparkPlug/GL/GpuTimer.h>
+#include <SparkPlug/GL/DebugOutput.h>
+#include <SparkPlug/GL/DeletionQueue.h>
+#include <SparkPlug/GL/NamePool.h>
 
 
 namespace SparkPlug
@@ -47,6 +63,47 @@ class Limits
 };
 
 
+/**
+ * Counts what the context did since the last Context::resetStats().
+ * *Requests are the calls made to the context,
+ * *Binds the OpenGL calls which were actually needed.
+ * Texture and sampler binds count units, so a multi-bind call counts once per unit.
+ * Updating them costs only an increment, so they're always on.
+ */
+class Statistics
+{
+	public:
+		Statistics();
+		void reset();
+		void print() const;
+
+		int objectsDeleted; // Names actually deleted, see DeletionQueue
+
+		int textureBindRequests;
+		int textureBinds;
+		int textureUnitEvictions; // By bindTextureAuto()
+		int samplerBindRequests;
+		int samplerBinds;
+		int programBindRequests;
+		int programBinds;
+		int bufferBindRequests;
+		int bufferBinds;
+		int vertexFormatRequests;
+		int vertexArrayBinds;
+		int vertexArraysCreated;
+		int pipelineStateChanges; // Raster, blend and depth stencil states which differed
+
+		int drawCalls;
+		int dispatchCalls;
+
+		int streamBufferStalls; // Waits for the GPU in StreamBuffer::endFrame()
+		int gpuTimerFramesDropped; // Frames GpuTimer had no results for yet
+		int uniformUploads;
+		unsigned long long bufferBytesUploaded;
+		unsigned long long textureBytesUploaded;
+};
+
+
 class TextureBinding
 {
 	public:
@@ -95,18 +152,106 @@ class BufferBinding
 };
 
 
+/**
+ * Bindings are deferred:
+ * bindTexture(), bindProgram() and so on only record what should be bound.
+ * The recorded state is sent to OpenGL by commitBindings(),
+ * which is done implicitly by the draw and dispatch functions.
+ * So scoped bindings cost nothing if nothing is drawn inside them.
+ *
+ * Call commitBindings() before issuing raw OpenGL calls
+ * which depend on the bindings.
+ */
 class Context
 {
 	public:
 		virtual ~Context();
 
 		const Limits& limits() const;
+		const Capabilities& capabilities() const;
+
+		/**
+		 * NULL if the object was destroyed or moved to another context.
+		 */
+		template<typename T>
+		T* resolve( Handle<T> handle ) const
+		{
+			return static_cast<T*>(m_ObjectPools[T::PoolType].get(handle.value()));
+		}
+
+		/**
+		 * Live objects of the type, indexed by handle.
+		 * Slots of destroyed objects are NULL until they're reused.
+		 */
+		const ObjectPool& objectPool( ObjectType type ) const;
+
+		/**
+		 * Contexts of one share group see the same textures, buffers,
+		 * programs and fences. Vertex arrays aren't shared.
+		 */
+		bool sharesObjectsWith( const Context* other ) const;
+
+		/**
+		 * Binds the context to the calling thread or releases it from it.
+		 * Only needed if the context is used by another thread
+		 * than the one which created it, see ResourceWorker.
+		 * The default implementation fails.
+		 */
+		virtual void makeCurrent();
+		virtual void releaseCurrent();
+
+		/**
+		 * Every OpenGL call of the library goes through this.
+		 * Valid after postInit(), unless a backend was given.
+		 */
+		Dispatch& gl();
+
+		/**
+		 * Puts the interceptor in front of the current chain,
+		 * so the last added one sees the calls first.
+		 * The context doesn't take ownership.
+		 * Interceptors must be removed before they are destroyed.
+		 */
+		void addInterceptor( Interceptor* interceptor );
+		void removeInterceptor( Interceptor* interceptor );
+
+		const Statistics& stats() const;
+		void resetStats(); // Usually once per frame
+
+		/**
+		 * NULL if timer queries aren't supported.
+		 * See GpuTimerScope.
+		 */
+		GpuTimer* gpuTimer();
+
+		/**
+		 * Call once per frame after the last draw.
+		 * Deletes the objects the GPU is done with
+		 * and checks for errors, depending on SPARKPLUG_GL_CHECK.
+		 */
+		void endFrame();
 
 		int activeTextureUnit() const;
 
 		void bindTexture( int unit, const StrongRef<Texture>& texture );
 		const StrongRef<Texture>& boundTexture( int unit ) const;
 
+		/**
+		 * Binds the texture to a unit chosen by the context
+		 * and returns the unit, for the sampler uniform.
+		 * A texture which is still bound keeps its unit,
+		 * otherwise a free or the least recently used unit is taken.
+		 * Units used since the last commit are never taken,
+		 * so a draw can use as many textures as there are units.
+		 */
+		int bindTextureAuto( const StrongRef<Texture>& texture );
+
+		/**
+		 * Units bindTextureAuto() may use, all by default.
+		 * Explicitly bound textures should use the others.
+		 */
+		void setAutoTextureUnits( int first, int count );
+
 		void bindSampler( int unit, const StrongRef<Sampler>& sampler );
 		const StrongRef<Sampler>& boundSampler( int unit ) const;
 
@@ -117,17 +262,168 @@ class Context
 		void unbindBuffer( BufferTarget target );
 		const StrongRef<Buffer>& boundBuffer( BufferTarget target ) const;
 
+		/**
+		 * Per instance attributes of the vertex format are read from this buffer,
+		 * starting at its beginning.
+		 */
+		void bindInstanceBuffer( const StrongRef<Buffer>& buffer );
+		const StrongRef<Buffer>& boundInstanceBuffer() const;
+
+		/**
+		 * Sources the attributes of format from the bound vertex buffer,
+		 * starting at data.
+		 * If vertex array objects are available, each distinct setup
+		 * (format, vertex buffer, index buffer, data) is recorded once
+		 * and later switches only cost a single glBindVertexArray.
+		 */
 		void setVertexFormat( const VertexFormat& format, void* data );
 
+		/**
+		 * Sends all bindings that changed since the last commit to OpenGL.
+		 */
+		void commitBindings();
+
+		/**
+		 * Unbinds everything and deletes the cached vertex arrays,
+		 * so the context doesn't reference any object anymore.
+		 * Needed before objects are moved to another context.
+		 */
+		void releaseBindings();
+
+		void draw( PrimitiveType primitive, int first, int count );
+
+		/**
+		 * Uses the bound index buffer.
+		 */
+		void drawElements( PrimitiveType primitive, int first, int count );
+
+		void drawInstanced( PrimitiveType primitive, int first, int count, int instanceCount );
+		void drawElementsInstanced( PrimitiveType primitive, int first, int count, int instanceCount );
+
+		/**
+		 * Adds baseVertex to each index before fetching the vertex.
+		 * Needs ARB_draw_elements_base_vertex.
+		 */
+		void drawElementsBaseVertex( PrimitiveType primitive, int first, int count, int baseVertex, int instanceCount = 1 );
+
+		/**
+		 * Issues drawCount DrawElementsIndirectCommand records
+		 * from the bound indirect buffer, starting at record first.
+		 * Uses the bound index buffer.
+		 */
+		void drawElementsIndirect( PrimitiveType primitive, int first, int drawCount );
+
+		void dispatch( int groupsX, int groupsY, int groupsZ );
+
+		/**
+		 * Binds everything the command needs without drawing it.
+		 * A command whose objects were destroyed asserts in debug builds.
+		 * Otherwise it returns false and binds nothing.
+		 */
+		bool bindDrawState( const DrawCommand& command );
+
+		/**
+		 * Sorts the list and draws its commands in that order.
+		 * Commands which refer to destroyed objects are skipped.
+		 * The bindings stay as the last command left them.
+		 */
+		void execute( DrawList& list );
+
+		/**
+		 * Replays the recorded commands in order.
+		 * Must be called by the thread which owns the context.
+		 */
+		void execute( const CommandBuffer& commands );
+
+
+		/**
+		 * Only the parts that differ from the currently applied state
+		 * are sent to OpenGL.
+		 * NULL restores the default state.
+		 */
+		void setRasterState( const StrongRef<RasterState>& state );
+		const StrongRef<RasterState>& rasterState() const;
+
+		void setBlendState( const StrongRef<BlendState>& state );
+		const StrongRef<BlendState>& blendState() const;
+
+		void setDepthStencilState( const StrongRef<DepthStencilState>& state );
+		const StrongRef<DepthStencilState>& depthStencilState() const;
+
+		void setViewport( int x, int y, int width, int height );
+		void setScissorRect( int x, int y, int width, int height );
+
+
+		/**
+		 * In asynchronous mode the driver doesn't wait for the events
+		 * to be handled. They're queued and onDebugEvent() is called
+		 * on a separate logger thread.
+		 */
+		void enableDebug( bool e, bool asynchronous = false );
+
+		/**
+		 * Filtered events are discarded by the driver already.
+		 */
+		void setDebugSourceEnabled( DebugEventSource source, bool enabled );
+		void setDebugTypeEnabled( DebugEventType type, bool enabled );
+		void setDebugSeverityEnabled( DebugEventSeverity severity, bool enabled );
+		void setDebugEventEnabled( DebugEventSource source, DebugEventType type, int id, bool enabled );
+
+		/**
+		 * Puts a marker into the command stream for debuggers like gDEBugger.
+		 * Does nothing without GREMEDY_string_marker.
+		 */
+		void debugMark( const char* message );
+
+		/**
+		 * Number of received events, including repeats which weren't delivered.
+		 */
+		int debugEventCount( DebugEventType type ) const;
 
-		void enableDebug( bool e );
+		/**
+		 * Events lost because the asynchronous queue was full.
+		 */
+		int droppedDebugEvents() const;
 
 	protected:
-		Context();
+		/**
+		 * Calls the backend instead of the driver, if one is given.
+		 * GLEW isn't initialized then. The context takes ownership.
+		 */
+		Context( Dispatch* backend = NULL );
+
+		Dispatch* backend();
 		void postInit();
 
+		/**
+		 * Call before postInit(), if the subclass created
+		 * the context sharing objects with the other one.
+		 */
+		void shareObjectsWith( const Context* other );
+
+		/**
+		 * Capabilities are loaded from this file and only probed
+		 * if it was written for another driver.
+		 * Updates are written back. Call before postInit().
+		 */
+		void setCapabilityFile( const char* file );
+
+		/**
+		 * Stops the asynchronous delivery of debug events
+		 * and frees everything the context holds in OpenGL:
+		 * bindings, cached vertex arrays, timer queries,
+		 * queued deletions and reserved names.
+		 * Subclasses must call it at the start of their destructor,
+		 * while the OpenGL context is still current.
+		 * Otherwise the logger thread could call onDebugEvent()
+		 * while the subclass is being destroyed, and the names would leak.
+		 */
+		void shutdown();
+
 		/**
 		 * The default action logs the errors.
+		 * Repeats of the same event are only delivered a few times per second.
+		 * Is called by the logger thread in asynchronous mode.
 		 */
 		virtual void onDebugEvent(
 			DebugEventSource source,
@@ -138,17 +434,175 @@ class Context
 		);
 
 	private:
+		friend class Buffer;
+		friend class StreamBuffer;
+		friend class Texture;
+		friend class Sampler;
+		friend class Program;
+		friend class RasterState;
+		friend class BlendState;
+		friend class DepthStencilState;
+		friend class DebugLogger;
+		friend class Fence;
+		friend class GpuTimer;
+		friend class DeletionQueue;
+		friend class NamePool;
+		friend class Object;
+
+		std::unique_ptr<Dispatch> m_OwnedBackend; // Declared first, so objects can still be released while destroying
+		DriverDispatch m_Driver;
+		Dispatch* m_Backend; // Driver or a replacement
+		Dispatch* m_Dispatch; // Head of the interceptor chain
+
+		// Before any reference, so objects can unregister while destroying
+		Statistics m_Stats;
+		ObjectPool m_ObjectPools[ObjectType_Count];
+		DeletionQueue m_DeletionQueue;
+		NamePool m_NamePool;
+
+		const Context* m_ShareGroup; // First context of the share group
+
+		std::string  m_CapabilityFile;
+		Capabilities m_Capabilities;
 		Limits* m_Limits;
+		GpuTimer*  m_GpuTimer;
 
 		int m_ActiveTextureUnit;
 		void selectTextureUnit( int unit );
-		StrongRef<Texture>* m_Textures; // Length is limits().maxTextureUnits
-		StrongRef<Sampler>* m_Samplers; // Length is limits().maxTextureUnits
+
+		// Requested bindings
+		StrongRef<Texture>* m_Textures; // Length is limits().maxCombinedTextureUnits
+		StrongRef<Sampler>* m_Samplers; // Length is limits().maxCombinedTextureUnits
  		StrongRef<Program> m_Program;
  		StrongRef<Buffer> m_Buffers[BufferTarget_Count];
+		StrongRef<Buffer> m_InstanceBuffer;
+		VertexFormat m_VertexFormat;
+		void*        m_VertexFormatData;
+		bool         m_HasVertexFormat;
+
+		// Bindings OpenGL currently uses
+		// Names instead of references, so dropped objects aren't kept alive.
+		// DeletionQueue resets them through forgetDeletedNames().
+		GLuint*      m_AppliedTextures;
+		TextureType* m_AppliedTextureTypes; // Target each applied texture is bound to, TextureType_Count if none
+		TextureType*        m_EnabledTextureTypes; // TextureType_Count if none
+
+		// Automatic texture units
+		int           m_AutoTextureUnitsFirst;
+		int           m_AutoTextureUnitsCount;
+		unsigned int* m_TextureUnitUses; // Commit count when each unit was last requested
+		unsigned int  m_CommitCount;
+		GLuint*             m_AppliedSamplers;
+		GLuint              m_AppliedProgram;
+		GLuint              m_AppliedBuffers[BufferTarget_Count]; // Index buffer of the bound vertex array
+		GLuint              m_DefaultIndexBuffer; // Index buffer of vertex array 0
+		GLuint              m_EditBuffer;
+
+		// Differences between both
+		enum DirtyState
+		{
+			DirtyState_Program     = 1 << 0,
+			DirtyState_VertexArray = 1 << 1,
+			DirtyState_FirstBuffer = 1 << 2 // One bit for each buffer target
+		};
+		unsigned int m_DirtyState;
+		DirtyMask m_DirtyTextures;
+		DirtyMask m_DirtyTextureTypes; // Enabled fixed function targets
+		DirtyMask m_DirtySamplers;
+		void setDirty( unsigned int state, bool dirty );
+		void updateTextureDirty( int unit );
+		void updateBufferDirty( BufferTarget target );
+
+		void applyTexture( int unit );
+		void bindTextureName( int unit, TextureType type, GLuint name ); // On the active unit
+		void unbindTextureTarget( int unit ); // On the active unit
+		void applyTextureType( int unit );
+		void applySampler( int unit );
+		void commitTextures();
+		void commitSamplers();
+		void applyProgram();
+		void applyBuffer( BufferTarget target );
+		void applyVertexArray();
+
+		/**
+		 * With direct state access objects are edited by name
+		 * and the bindings stay untouched.
+		 */
+		bool m_DirectStateAccess;
 
-		VertexAttribute* m_Attributes; // Length is limits().maxVertexAttributes
-		int m_ActiveAttributes;
+		/**
+		 * Objects which need to be bound to be edited,
+		 * use these to bind themselves immediately.
+		 * The requested bindings are restored on the next commit.
+		 * Only needed without direct state access.
+		 */
+		void bindTextureForEdit( Texture* texture );
+		void bindProgramForEdit( const StrongRef<Program>& program );
+		GLenum bindBufferForEdit( Buffer* buffer ); // Returns the target to use
+		bool m_UseEditBufferTarget;
+
+		/**
+		 * With ARB_multi_bind each range of dirty texture or sampler units
+		 * is bound with a single call.
+		 */
+		bool m_UseMultiBind;
+		std::vector<GLuint> m_MultiBindNames;
+
+		bool m_UseDrawIndirect;
+		bool m_UseMultiDrawIndirect;
+		bool m_UseComputeShader;
+
+		bool m_UseSync; // Fences, otherwise they finish all commands
+		bool m_UseBufferStorage; // Persistently mapped stream buffers
+		bool m_UseMapBufferRange;
+
+		VertexAttribute* m_Attributes; // Attribute starting at each location, length is limits().maxVertexAttributes
+		int* m_AttributeOffsets; // Length is limits().maxVertexAttributes
+		int m_ActiveLocations;
+		GLuint m_AttributeBuffer; // Vertex buffer the attributes were set up with
+		void*  m_AttributeData;
+		int    m_AttributeStride;
+		GLuint m_AttributeInstanceBuffer;
+		int    m_AttributeInstanceStride;
+		void setVertexAttributes( const VertexFormat& format, void* data, bool diff );
+		void bindArrayBuffer( const StrongRef<Buffer>& buffer );
+
+		bool m_UseDrawInstanced;
+		bool m_UseDrawElementsBaseVertex;
+		bool m_UseInstancedArrays; // Attribute divisors
+
+		bool   m_UseVertexArrays;
+		GLuint m_VertexArray;
+		VertexArrayCache m_VertexArrays;
+		void bindVertexArray( GLuint vertexArray );
+		void leaveVertexArray(); // Switches to vertex array 0 before touching the index buffer
+		void releaseVertexArrays( GLuint buffer ); // Called by forgetDeletedNames()
+
+		/**
+		 * Deleting a name unbinds it, so applied bindings with that name are reset.
+		 * Called by DeletionQueue right before the names are deleted.
+		 */
+		void forgetDeletedNames( ObjectType type, const std::vector<GLuint>& names );
+
+		// Shared state objects, see RasterState::Create and friends
+		std::multimap<unsigned int, StrongRef<RasterState> >       m_RasterStates;
+		std::multimap<unsigned int, StrongRef<BlendState> >        m_BlendStates;
+		std::multimap<unsigned int, StrongRef<DepthStencilState> > m_DepthStencilStates;
+
+		StrongRef<RasterState>       m_RasterState;
+		StrongRef<BlendState>        m_BlendState;
+		StrongRef<DepthStencilState> m_DepthStencilState;
+
+		// What OpenGL currently uses
+		RasterStateDesc       m_RasterShadow;
+		BlendStateDesc        m_BlendShadow;
+		DepthStencilStateDesc m_DepthStencilShadow;
+		int m_Viewport[4];
+		int m_ScissorRect[4];
+
+		void applyRasterState( const RasterStateDesc& desc );
+		void applyBlendState( const BlendStateDesc& desc );
+		void applyDepthStencilState( const DepthStencilStateDesc& desc );
 
 
 		static void onDebugEventWrapper(
@@ -161,6 +615,14 @@ class Context
 			void* userParam
 		);
 
+		void deliverDebugEvent(
+			DebugEventSource source,
+			DebugEventType type,
+			int id,
+			DebugEventSeverity severity,
+			const char* message
+		);
+
 		void emitDebugMessage(
 			DebugEventSource source,
 			DebugEventType type,
@@ -171,6 +633,17 @@ class Context
 
 
 		bool m_Debug;
+		bool m_UseDebugOutput;
+		DebugLogger* m_DebugLogger; // Only in asynchronous mode
+		std::atomic<int> m_DebugEventCounts[DebugEventType_Count];
+		struct DebugEventRepeats
+		{
+			DebugEventRepeats() : count(0) {}
+
+			std::chrono::steady_clock::time_point windowStart;
+			int count; // Since windowStart
+		};
+		std::map<unsigned long long, DebugEventRepeats> m_DebugEventRepeats; // Only touched by the delivering thread
 };
 
 }
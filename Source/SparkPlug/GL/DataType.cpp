@@ -446,8 +446,8 @@ bool DataType::operator == ( const DataType& other ) const
 {
 	return
 		(m_PrimitiveDataType == other.m_PrimitiveDataType) &&
-		(m_CompositeSize == other.m_CompositeSize) &&
-		(m_CompositeSize == m_CompositeSize);
+		(m_CompositeDataType == other.m_CompositeDataType) &&
+		(m_CompositeSize == other.m_CompositeSize);
 }
 
 bool DataType::operator != ( const DataType& other ) const
@@ -0,0 +1,135 @@
+#include <cstring>
+#include <chrono>
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/Context.h>
+#include <SparkPlug/GL/DebugOutput.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/// ---- DebugEventQueue ----
+
+DebugEventQueue::DebugEventQueue() :
+	m_Head(0),
+	m_Tail(0)
+{
+	// A slot is free for position p if its sequence is p,
+	// and readable if its sequence is p+1.
+	for(int i = 0; i < Capacity; ++i)
+		m_Slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool DebugEventQueue::push( DebugEventSource source, DebugEventType type, int id, DebugEventSeverity severity, const char* message, int length )
+{
+	unsigned int position = m_Head.load(std::memory_order_relaxed);
+	Slot* slot = NULL;
+	for(;;)
+	{
+		slot = &m_Slots[position & (Capacity-1)];
+		unsigned int sequence = slot->sequence.load(std::memory_order_acquire);
+		int difference = int(sequence - position);
+
+		if(difference == 0)
+		{
+			if(m_Head.compare_exchange_weak(position, position+1, std::memory_order_relaxed))
+				break;
+		}
+		else if(difference < 0)
+		{
+			return false; // Full
+		}
+		else
+		{
+			position = m_Head.load(std::memory_order_relaxed);
+		}
+	}
+
+	DebugEvent& event = slot->event;
+	event.source   = source;
+	event.type     = type;
+	event.id       = id;
+	event.severity = severity;
+
+	if(length < 0)
+		length = std::strlen(message);
+	if(length > DebugEvent::MaxMessageLength-1)
+		length = DebugEvent::MaxMessageLength-1;
+	std::memcpy(event.message, message, length);
+	event.message[length] = '\0';
+
+	slot->sequence.store(position+1, std::memory_order_release);
+	return true;
+}
+
+bool DebugEventQueue::pop( DebugEvent* event )
+{
+	Slot& slot = m_Slots[m_Tail & (Capacity-1)];
+	unsigned int sequence = slot.sequence.load(std::memory_order_acquire);
+	if(int(sequence - (m_Tail+1)) < 0)
+		return false; // Empty or still being written
+
+	*event = slot.event;
+	slot.sequence.store(m_Tail+Capacity, std::memory_order_release);
+	++m_Tail;
+	return true;
+}
+
+
+/// ---- DebugLogger ----
+
+DebugLogger::DebugLogger( Context* context ) :
+	m_Context(context),
+	m_Dropped(0),
+	m_Running(true)
+{
+	m_Thread = std::thread(&DebugLogger::run, this);
+}
+
+DebugLogger::~DebugLogger()
+{
+	m_Running = false;
+	m_Wake.notify_one();
+	m_Thread.join();
+
+	if(m_Dropped > 0)
+		LogWarning("Dropped %d OpenGL debug events, because the queue was full.", m_Dropped.load());
+}
+
+void DebugLogger::push( DebugEventSource source, DebugEventType type, int id, DebugEventSeverity severity, const char* message, int length )
+{
+	if(m_Queue.push(source, type, id, severity, message, length))
+		m_Wake.notify_one();
+	else
+		++m_Dropped;
+}
+
+int DebugLogger::droppedEvents() const
+{
+	return m_Dropped;
+}
+
+void DebugLogger::run()
+{
+	while(m_Running)
+	{
+		drain();
+
+		// Pushing doesn't take the lock, so a wake up may be missed.
+		// The timeout bounds the delay in that case.
+		std::unique_lock<std::mutex> lock(m_WakeMutex);
+		m_Wake.wait_for(lock, std::chrono::milliseconds(10));
+	}
+	drain();
+}
+
+void DebugLogger::drain()
+{
+	DebugEvent event;
+	while(m_Queue.pop(&event))
+		m_Context->deliverDebugEvent(event.source, event.type, event.id, event.severity, event.message);
+}
+
+}
+}
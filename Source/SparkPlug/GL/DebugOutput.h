@@ -0,0 +1,105 @@
+#ifndef __SPARKPLUG_GL_DEBUG_OUTPUT__
+#define __SPARKPLUG_GL_DEBUG_OUTPUT__
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <SparkPlug/GL/Enums.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+class Context;
+
+class DebugEvent
+{
+public:
+	static const int MaxMessageLength = 512; // Longer messages are truncated
+
+	DebugEventSource   source;
+	DebugEventType     type;
+	int                id;
+	DebugEventSeverity severity;
+	char               message[MaxMessageLength];
+};
+
+/**
+ * Bounded multi producer, single consumer ring.
+ * The driver may call the debug callback from several threads at once,
+ * so pushing is lock free and never blocks.
+ */
+class DebugEventQueue
+{
+public:
+	static const int Capacity = 256; // Must be a power of two
+
+	DebugEventQueue();
+
+	/**
+	 * Returns false if the queue is full.
+	 */
+	bool push( DebugEventSource source, DebugEventType type, int id, DebugEventSeverity severity, const char* message, int length );
+
+	/**
+	 * Must only be called by the consumer.
+	 */
+	bool pop( DebugEvent* event );
+
+private:
+	struct Slot
+	{
+		std::atomic<unsigned int> sequence;
+		DebugEvent event;
+	};
+
+	Slot m_Slots[Capacity];
+	std::atomic<unsigned int> m_Head; // Next slot to write
+	unsigned int m_Tail; // Next slot to read
+};
+
+/**
+ * Delivers debug events to Context::onDebugEvent() on its own thread,
+ * so the driver doesn't wait for formatting and logging.
+ */
+class DebugLogger
+{
+public:
+	DebugLogger( Context* context );
+
+	/**
+	 * Delivers the remaining events before returning.
+	 */
+	~DebugLogger();
+
+	void push( DebugEventSource source, DebugEventType type, int id, DebugEventSeverity severity, const char* message, int length );
+
+	/**
+	 * Events lost because the queue was full.
+	 */
+	int droppedEvents() const;
+
+private:
+	DebugLogger( const DebugLogger& source );
+	DebugLogger& operator = ( const DebugLogger& source );
+
+	void run();
+	void drain();
+
+	Context* m_Context;
+	DebugEventQueue m_Queue;
+	std::atomic<int> m_Dropped;
+
+	std::atomic<bool> m_Running;
+	std::mutex m_WakeMutex;
+	std::condition_variable m_Wake;
+	std::thread m_Thread;
+};
+
+}
+}
+
+#endif
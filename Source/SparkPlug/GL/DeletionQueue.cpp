@@ -0,0 +1,156 @@
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/Context.h>
+#include <SparkPlug/GL/DeletionQueue.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/// ---- DeletionQueue ----
+
+DeletionQueue::DeletionQueue( Context* context ) :
+	m_Context(context),
+	m_QueuedCount(0)
+{
+}
+
+DeletionQueue::~DeletionQueue()
+{
+	flush();
+}
+
+void DeletionQueue::push( ObjectType type, GLuint name )
+{
+	assert(InsideArray(type, ObjectType_Count));
+	if(!name)
+		return;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_Queued[type].push_back(name);
+	++m_QueuedCount;
+}
+
+void DeletionQueue::pushSync( GLsync sync )
+{
+	if(!sync)
+		return;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_QueuedSyncs.push_back(sync);
+	++m_QueuedCount;
+}
+
+void DeletionQueue::flushIfFull()
+{
+	// Nobody calls endFrame(), or a lot is destroyed at once.
+	// OpenGL keeps objects alive while the GPU uses them,
+	// so deleting without a fence is safe.
+	if(m_QueuedCount >= MaxQueuedNames)
+		deleteNames(takeQueued());
+}
+
+DeletionQueue::Batch* DeletionQueue::takeQueued()
+{
+	if(!m_QueuedCount)
+		return NULL;
+
+	Batch* batch = new Batch(m_Context);
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	for(int i = 0; i < ObjectType_Count; ++i)
+		batch->names[i].swap(m_Queued[i]);
+	batch->syncs.swap(m_QueuedSyncs);
+	m_QueuedCount = 0;
+	return batch;
+}
+
+void DeletionQueue::endFrame()
+{
+	Batch* batch = takeQueued();
+	if(batch)
+	{
+		if(m_Context->m_UseSync)
+		{
+			batch->fence.insert();
+			m_InFlight.push_back(batch);
+		}
+		else
+		{
+			// Waiting for a fence would finish the frame.
+			deleteNames(batch);
+		}
+	}
+
+	// Fences are signaled in order.
+	while(!m_InFlight.empty() && m_InFlight.front()->fence.isSignaled())
+	{
+		deleteNames(m_InFlight.front());
+		m_InFlight.pop_front();
+	}
+}
+
+void DeletionQueue::flush()
+{
+	for(; !m_InFlight.empty(); m_InFlight.pop_front())
+		deleteNames(m_InFlight.front());
+
+	Batch* batch = takeQueued();
+	if(batch)
+		deleteNames(batch);
+}
+
+void DeletionQueue::deleteNames( Batch* batch )
+{
+	if(!batch)
+		return;
+
+	Dispatch& gl = m_Context->gl();
+	int count = 0;
+
+	for(int i = 0; i < ObjectType_Count; ++i)
+	{
+		const std::vector<GLuint>& names = batch->names[i];
+		if(names.empty())
+			continue;
+		count += names.size();
+		m_Context->forgetDeletedNames(ObjectType(i), names);
+
+		switch(ObjectType(i))
+		{
+			case ObjectType_Buffer:
+				gl.DeleteBuffersARB(names.size(), &names[0]);
+				break;
+
+			case ObjectType_Texture:
+				gl.DeleteTextures(names.size(), &names[0]);
+				break;
+
+			case ObjectType_Sampler:
+				gl.DeleteSamplers(names.size(), &names[0]);
+				break;
+
+			// No batched variants for these.
+			case ObjectType_Shader:
+				for(std::size_t j = 0; j < names.size(); ++j)
+					gl.DeleteShader(names[j]);
+				break;
+
+			case ObjectType_Program:
+				for(std::size_t j = 0; j < names.size(); ++j)
+					gl.DeleteProgram(names[j]);
+				break;
+
+			case ObjectType_Count:
+				;
+		}
+	}
+
+	for(std::size_t i = 0; i < batch->syncs.size(); ++i)
+		gl.DeleteSync(batch->syncs[i]);
+
+	m_Context->m_Stats.objectsDeleted += count;
+	delete batch;
+}
+
+}
+}
@@ -0,0 +1,97 @@
+#ifndef __SPARKPLUG_GL_DELETION_QUEUE__
+#define __SPARKPLUG_GL_DELETION_QUEUE__
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <SparkPlug/GL/OpenGL.h>
+#include <SparkPlug/GL/ObjectPool.h>
+#include <SparkPlug/GL/Fence.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+class Context;
+
+/**
+ * Collects the names of destroyed objects, so they can be deleted
+ * in batches once the GPU is done with the frames that used them.
+ * Without ARB_sync they're deleted at the end of the frame.
+ * If endFrame() isn't called, names are deleted when the next object
+ * is created once MaxQueuedNames of them piled up.
+ *
+ * Objects may be destroyed on any thread. Their names wait in the queue
+ * until the thread which owns the context deletes them.
+ */
+class DeletionQueue
+{
+public:
+	static const int MaxQueuedNames = 4096;
+
+	DeletionQueue( Context* context );
+
+	/**
+	 * Deletes the remaining names right away.
+	 */
+	~DeletionQueue();
+
+	/**
+	 * May be called from any thread.
+	 */
+	void push( ObjectType type, GLuint name );
+	void pushSync( GLsync sync );
+
+	/**
+	 * Deletes the queued names right away if MaxQueuedNames piled up.
+	 * Called by Object::Object() on the thread which owns the context.
+	 */
+	void flushIfFull();
+
+	/**
+	 * Fences the names queued during the frame
+	 * and deletes the ones whose fence is signaled.
+	 * Called by Context::endFrame() on the thread which owns the context.
+	 */
+	void endFrame();
+
+	/**
+	 * Deletes all queued names without waiting.
+	 * OpenGL keeps objects alive while the GPU still uses them,
+	 * so this is always safe, just not spread over frames.
+	 */
+	void flush();
+
+private:
+	DeletionQueue( const DeletionQueue& source );
+	DeletionQueue& operator = ( const DeletionQueue& source );
+
+	struct Batch
+	{
+		Batch( Context* context ) : fence(context) {}
+
+		std::vector<GLuint> names[ObjectType_Count];
+		std::vector<GLsync> syncs;
+		Fence fence;
+	};
+
+	Batch* takeQueued();
+	void deleteNames( Batch* batch );
+
+	Context* m_Context;
+
+	std::mutex m_Mutex; // Guards the queued names
+	std::vector<GLuint> m_Queued[ObjectType_Count]; // Since the last endFrame()
+	std::vector<GLsync> m_QueuedSyncs;
+	std::atomic<int> m_QueuedCount;
+
+	std::deque<Batch*> m_InFlight; // Waiting for their fence
+};
+
+}
+}
+
+#endif
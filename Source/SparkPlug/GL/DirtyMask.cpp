@@ -0,0 +1,93 @@
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/DirtyMask.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+const int BitsPerWord = sizeof(unsigned int)*8;
+
+DirtyMask::DirtyMask() :
+	m_Size(0),
+	m_DirtyCount(0)
+{
+}
+
+void DirtyMask::resize( int size )
+{
+	m_Words.assign((size+BitsPerWord-1)/BitsPerWord, 0);
+	m_Size = size;
+	m_DirtyCount = 0;
+}
+
+int DirtyMask::size() const
+{
+	return m_Size;
+}
+
+void DirtyMask::set( int i, bool dirty )
+{
+	assert(InsideArray(i, m_Size));
+
+	unsigned int& word = m_Words[i/BitsPerWord];
+	unsigned int bit = 1u << (i%BitsPerWord);
+
+	if(dirty == ((word & bit) != 0))
+		return;
+
+	if(dirty)
+	{
+		word |= bit;
+		++m_DirtyCount;
+	}
+	else
+	{
+		word &= ~bit;
+		--m_DirtyCount;
+	}
+}
+
+bool DirtyMask::test( int i ) const
+{
+	assert(InsideArray(i, m_Size));
+	return (m_Words[i/BitsPerWord] & (1u << (i%BitsPerWord))) != 0;
+}
+
+bool DirtyMask::any() const
+{
+	return m_DirtyCount > 0;
+}
+
+void DirtyMask::clear()
+{
+	if(m_DirtyCount == 0)
+		return;
+	m_Words.assign(m_Words.size(), 0);
+	m_DirtyCount = 0;
+}
+
+int DirtyMask::next( int i ) const
+{
+	if(m_DirtyCount == 0)
+		return -1;
+
+	int wordCount = m_Words.size();
+	for(int w = i/BitsPerWord; w < wordCount; ++w)
+	{
+		unsigned int word = m_Words[w];
+		if(w == i/BitsPerWord)
+			word &= ~0u << (i%BitsPerWord);
+		if(!word)
+			continue;
+
+		int bit = 0;
+		while(!(word & (1u << bit)))
+			++bit;
+		return w*BitsPerWord + bit;
+	}
+	return -1;
+}
+
+}
+}
@@ -0,0 +1,44 @@
+#ifndef __SPARKPLUG_GL_DIRTY_MASK__
+#define __SPARKPLUG_GL_DIRTY_MASK__
+
+#include <vector>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/**
+ * Fixed size bit set which remembers which slots
+ * (e.g. texture units) need to be sent to OpenGL.
+ */
+class DirtyMask
+{
+public:
+	DirtyMask();
+
+	void resize( int size );
+	int size() const;
+
+	void set( int i, bool dirty );
+	bool test( int i ) const;
+
+	bool any() const;
+	void clear();
+
+	/**
+	 * Returns the first dirty index which is >= i or -1 if there is none.
+	 */
+	int next( int i ) const;
+
+private:
+	std::vector<unsigned int> m_Words;
+	int m_Size;
+	int m_DirtyCount;
+};
+
+}
+}
+
+#endif
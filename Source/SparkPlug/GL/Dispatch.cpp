@@ -0,0 +1,209 @@
+#include <chrono>
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/Dispatch.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+const char* AsString( DispatchFunction function )
+{
+	switch(function)
+	{
+#define SPARKPLUG_GL_NAME(R, Name, Params, Args) case DispatchFunction_##Name: return "gl" #Name;
+		SPARKPLUG_GL_FUNCTIONS(SPARKPLUG_GL_NAME)
+#undef SPARKPLUG_GL_NAME
+		case DispatchFunction_Count: ;
+	}
+	FatalError("Unknown dispatch function: %d", function);
+	return NULL;
+}
+
+
+/// ---- Dispatch ----
+
+Dispatch::~Dispatch()
+{
+}
+
+
+/// ---- DriverDispatch ----
+
+DriverDispatch::DriverDispatch()
+{
+#define SPARKPLUG_GL_CLEAR(R, Name, Params, Args) m_##Name = NULL;
+	SPARKPLUG_GL_FUNCTIONS(SPARKPLUG_GL_CLEAR)
+#undef SPARKPLUG_GL_CLEAR
+}
+
+void DriverDispatch::load()
+{
+	// gl##Name expands to GLEW's function pointer or the exported function.
+#define SPARKPLUG_GL_LOAD(R, Name, Params, Args) m_##Name = gl##Name;
+	SPARKPLUG_GL_FUNCTIONS(SPARKPLUG_GL_LOAD)
+#undef SPARKPLUG_GL_LOAD
+}
+
+bool DriverDispatch::isSupported( const char* name )
+{
+	return glewIsSupported(name) == GL_TRUE;
+}
+
+#define SPARKPLUG_GL_DEFINE(R, Name, Params, Args) \
+	R DriverDispatch::Name Params \
+	{ \
+		return m_##Name Args; \
+	}
+SPARKPLUG_GL_FUNCTIONS(SPARKPLUG_GL_DEFINE)
+#undef SPARKPLUG_GL_DEFINE
+
+
+/// ---- Interceptor ----
+
+Interceptor::Interceptor() :
+	m_Next(NULL)
+{
+}
+
+Interceptor::~Interceptor()
+{
+	if(m_Next)
+		FatalError("Interceptor destroyed while it is still part of a chain.");
+}
+
+Dispatch* Interceptor::next() const
+{
+	return m_Next;
+}
+
+bool Interceptor::isSupported( const char* name )
+{
+	return m_Next->isSupported(name);
+}
+
+void Interceptor::beginCall( DispatchFunction function )
+{
+}
+
+void Interceptor::endCall( DispatchFunction function )
+{
+}
+
+Interceptor::CallScope::CallScope( Interceptor* interceptor, DispatchFunction function ) :
+	m_Interceptor(interceptor),
+	m_Function(function)
+{
+	m_Interceptor->beginCall(m_Function);
+}
+
+Interceptor::CallScope::~CallScope()
+{
+	m_Interceptor->endCall(m_Function);
+}
+
+#define SPARKPLUG_GL_DEFINE(R, Name, Params, Args) \
+	R Interceptor::Name Params \
+	{ \
+		CallScope scope(this, DispatchFunction_##Name); \
+		return m_Next->Name Args; \
+	}
+SPARKPLUG_GL_FUNCTIONS(SPARKPLUG_GL_DEFINE)
+#undef SPARKPLUG_GL_DEFINE
+
+
+/// ---- CallTracer ----
+
+void CallTracer::beginCall( DispatchFunction function )
+{
+	Log("%s", AsString(function));
+}
+
+
+/// ---- CallCounter ----
+
+CallCounter::CallCounter()
+{
+	reset();
+}
+
+int CallCounter::count( DispatchFunction function ) const
+{
+	assert(InsideArray(function, DispatchFunction_Count));
+	return m_Counts[function];
+}
+
+int CallCounter::totalCount() const
+{
+	int total = 0;
+	for(int i = 0; i < DispatchFunction_Count; ++i)
+		total += m_Counts[i];
+	return total;
+}
+
+void CallCounter::reset()
+{
+	for(int i = 0; i < DispatchFunction_Count; ++i)
+		m_Counts[i] = 0;
+}
+
+void CallCounter::print() const
+{
+	Log("OpenGL calls: %d", totalCount());
+	for(int i = 0; i < DispatchFunction_Count; ++i)
+		if(m_Counts[i] > 0)
+			Log("  %s: %d", AsString((DispatchFunction)i), m_Counts[i]);
+}
+
+void CallCounter::beginCall( DispatchFunction function )
+{
+	++m_Counts[function];
+}
+
+
+/// ---- CallTimer ----
+
+unsigned long long NowInNanoseconds()
+{
+	using namespace std::chrono;
+	return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+CallTimer::CallTimer() :
+	m_Begin(0)
+{
+	reset();
+}
+
+double CallTimer::milliseconds( DispatchFunction function ) const
+{
+	assert(InsideArray(function, DispatchFunction_Count));
+	return double(m_Nanoseconds[function]) / 1000000.0;
+}
+
+void CallTimer::reset()
+{
+	for(int i = 0; i < DispatchFunction_Count; ++i)
+		m_Nanoseconds[i] = 0;
+}
+
+void CallTimer::print() const
+{
+	Log("OpenGL call times:");
+	for(int i = 0; i < DispatchFunction_Count; ++i)
+		if(m_Nanoseconds[i] > 0)
+			Log("  %s: %.3f ms", AsString((DispatchFunction)i), milliseconds((DispatchFunction)i));
+}
+
+void CallTimer::beginCall( DispatchFunction function )
+{
+	m_Begin = NowInNanoseconds();
+}
+
+void CallTimer::endCall( DispatchFunction function )
+{
+	m_Nanoseconds[function] += NowInNanoseconds() - m_Begin;
+}
+
+}
+}
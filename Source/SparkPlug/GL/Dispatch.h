@@ -0,0 +1,320 @@
+#ifndef __SPARKPLUG_GL_DISPATCH__
+#define __SPARKPLUG_GL_DISPATCH__
+
+#include <SparkPlug/GL/OpenGL.h>
+
+
+/**
+ * Every OpenGL function the library calls, as
+ * F( return type, name, (parameters), (arguments) )
+ * The gl prefix is left out, because GLEW defines those names as macros.
+ */
+#define SPARKPLUG_GL_FUNCTIONS(F) \
+	F(void, ActiveTextureARB, (GLenum texture), (texture)) \
+	F(void, AttachShader, (GLuint program, GLuint shader), (program, shader)) \
+	F(void, BindAttribLocation, (GLuint program, GLuint index, const GLchar* name), (program, index, name)) \
+	F(void, BindBufferARB, (GLenum target, GLuint buffer), (target, buffer)) \
+	F(void, BindSampler, (GLuint unit, GLuint sampler), (unit, sampler)) \
+	F(void, BindSamplers, (GLuint first, GLsizei count, const GLuint* samplers), (first, count, samplers)) \
+	F(void, BindTexture, (GLenum target, GLuint texture), (target, texture)) \
+	F(void, BindTextures, (GLuint first, GLsizei count, const GLuint* textures), (first, count, textures)) \
+	F(void, BindVertexArray, (GLuint array), (array)) \
+	F(void, BlendEquationSeparate, (GLenum modeRGB, GLenum modeAlpha), (modeRGB, modeAlpha)) \
+	F(void, BlendFuncSeparate, (GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha), (sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha)) \
+	F(void, BufferDataARB, (GLenum target, GLsizeiptrARB size, const void* data, GLenum usage), (target, size, data, usage)) \
+	F(void, BufferStorage, (GLenum target, GLsizeiptr size, const void* data, GLbitfield flags), (target, size, data, flags)) \
+	F(void, BufferSubDataARB, (GLenum target, GLintptrARB offset, GLsizeiptrARB size, const void* data), (target, offset, size, data)) \
+	F(GLenum, ClientWaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout), (sync, flags, timeout)) \
+	F(void, ColorMask, (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha), (red, green, blue, alpha)) \
+	F(void, CompileShader, (GLuint shader), (shader)) \
+	F(void, CreateBuffers, (GLsizei n, GLuint* buffers), (n, buffers)) \
+	F(GLuint, CreateProgram, (), ()) \
+	F(GLuint, CreateShader, (GLenum type), (type)) \
+	F(void, CreateTextures, (GLenum target, GLsizei n, GLuint* textures), (target, n, textures)) \
+	F(void, CullFace, (GLenum mode), (mode)) \
+	F(void, DebugMessageCallbackARB, (GLDEBUGPROCARB callback, const void* userParam), (callback, userParam)) \
+	F(void, DebugMessageControlARB, (GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint* ids, GLboolean enabled), (source, type, severity, count, ids, enabled)) \
+	F(void, DebugMessageInsertARB, (GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* buf), (source, type, id, severity, length, buf)) \
+	F(void, DeleteBuffersARB, (GLsizei n, const GLuint* buffers), (n, buffers)) \
+	F(void, DeleteProgram, (GLuint program), (program)) \
+	F(void, DeleteQueries, (GLsizei n, const GLuint* ids), (n, ids)) \
+	F(void, DeleteSamplers, (GLsizei count, const GLuint* samplers), (count, samplers)) \
+	F(void, DeleteShader, (GLuint shader), (shader)) \
+	F(void, DeleteSync, (GLsync sync), (sync)) \
+	F(void, DeleteTextures, (GLsizei n, const GLuint* textures), (n, textures)) \
+	F(void, DeleteVertexArrays, (GLsizei n, const GLuint* arrays), (n, arrays)) \
+	F(void, DepthFunc, (GLenum func), (func)) \
+	F(void, DepthMask, (GLboolean flag), (flag)) \
+	F(void, DetachShader, (GLuint program, GLuint shader), (program, shader)) \
+	F(void, Disable, (GLenum cap), (cap)) \
+	F(void, DisableVertexAttribArray, (GLuint index), (index)) \
+	F(void, DispatchCompute, (GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z), (num_groups_x, num_groups_y, num_groups_z)) \
+	F(void, DrawArrays, (GLenum mode, GLint first, GLsizei count), (mode, first, count)) \
+	F(void, DrawArraysInstanced, (GLenum mode, GLint first, GLsizei count, GLsizei instancecount), (mode, first, count, instancecount)) \
+	F(void, DrawElements, (GLenum mode, GLsizei count, GLenum type, const void* indices), (mode, count, type, indices)) \
+	F(void, DrawElementsBaseVertex, (GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex), (mode, count, type, indices, basevertex)) \
+	F(void, DrawElementsIndirect, (GLenum mode, GLenum type, const void* indirect), (mode, type, indirect)) \
+	F(void, DrawElementsInstanced, (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount), (mode, count, type, indices, instancecount)) \
+	F(void, Enable, (GLenum cap), (cap)) \
+	F(void, EnableVertexAttribArray, (GLuint index), (index)) \
+	F(void, DrawElementsInstancedBaseVertex, (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount, GLint basevertex), (mode, count, type, indices, instancecount, basevertex)) \
+	F(GLsync, FenceSync, (GLenum condition, GLbitfield flags), (condition, flags)) \
+	F(void, Finish, (), ()) \
+	F(void, Flush, (), ()) \
+	F(void, FlushMappedBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length), (target, offset, length)) \
+	F(void, FlushMappedNamedBufferRange, (GLuint buffer, GLintptr offset, GLsizeiptr length), (buffer, offset, length)) \
+	F(void, FrontFace, (GLenum mode), (mode)) \
+	F(void, GenBuffersARB, (GLsizei n, GLuint* buffers), (n, buffers)) \
+	F(void, GenQueries, (GLsizei n, GLuint* ids), (n, ids)) \
+	F(void, GenSamplers, (GLsizei count, GLuint* samplers), (count, samplers)) \
+	F(void, GenTextures, (GLsizei n, GLuint* textures), (n, textures)) \
+	F(void, GenVertexArrays, (GLsizei n, GLuint* arrays), (n, arrays)) \
+	F(void, GenerateTextureMipmap, (GLuint texture), (texture)) \
+	F(void, GetActiveAttrib, (GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name), (program, index, bufSize, length, size, type, name)) \
+	F(void, GetActiveUniform, (GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name), (program, index, bufSize, length, size, type, name)) \
+	F(void, GetBufferSubDataARB, (GLenum target, GLintptrARB offset, GLsizeiptrARB size, void* data), (target, offset, size, data)) \
+	F(GLenum, GetError, (), ()) \
+	F(void, GetFloatv, (GLenum pname, GLfloat* params), (pname, params)) \
+	F(void, GetIntegerv, (GLenum pname, GLint* params), (pname, params)) \
+	F(void, GetInternalformativ, (GLenum target, GLenum internalformat, GLenum pname, GLsizei bufSize, GLint* params), (target, internalformat, pname, bufSize, params)) \
+	F(void, GetNamedBufferSubData, (GLuint buffer, GLintptr offset, GLsizeiptr size, void* data), (buffer, offset, size, data)) \
+	F(void, GetProgramInfoLog, (GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog), (program, bufSize, length, infoLog)) \
+	F(void, GetProgramiv, (GLuint program, GLenum pname, GLint* params), (program, pname, params)) \
+	F(void, GetQueryObjectiv, (GLuint id, GLenum pname, GLint* params), (id, pname, params)) \
+	F(void, GetQueryObjectui64v, (GLuint id, GLenum pname, GLuint64* params), (id, pname, params)) \
+	F(void, GetShaderInfoLog, (GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog), (shader, bufSize, length, infoLog)) \
+	F(void, GetShaderiv, (GLuint shader, GLenum pname, GLint* params), (shader, pname, params)) \
+	F(const GLubyte*, GetString, (GLenum name), (name)) \
+	F(void, GetTexLevelParameteriv, (GLenum target, GLint level, GLenum pname, GLint* params), (target, level, pname, params)) \
+	F(GLint, GetUniformLocation, (GLuint program, const GLchar* name), (program, name)) \
+	F(void, LinkProgram, (GLuint program), (program)) \
+	F(void*, MapBufferARB, (GLenum target, GLenum access), (target, access)) \
+	F(void*, MapBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access), (target, offset, length, access)) \
+	F(void*, MapNamedBuffer, (GLuint buffer, GLenum access), (buffer, access)) \
+	F(void*, MapNamedBufferRange, (GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access), (buffer, offset, length, access)) \
+	F(void, MultiDrawElementsIndirect, (GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride), (mode, type, indirect, drawcount, stride)) \
+	F(void, NamedBufferData, (GLuint buffer, GLsizeiptr size, const void* data, GLenum usage), (buffer, size, data, usage)) \
+	F(void, NamedBufferStorage, (GLuint buffer, GLsizeiptr size, const void* data, GLbitfield flags), (buffer, size, data, flags)) \
+	F(void, NamedBufferSubData, (GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data), (buffer, offset, size, data)) \
+	F(void, PolygonMode, (GLenum face, GLenum mode), (face, mode)) \
+	F(void, PolygonOffset, (GLfloat factor, GLfloat units), (factor, units)) \
+	F(void, ProgramUniform1f, (GLuint program, GLint location, GLfloat v0), (program, location, v0)) \
+	F(void, ProgramUniform1fv, (GLuint program, GLint location, GLsizei count, const GLfloat* value), (program, location, count, value)) \
+	F(void, ProgramUniform1i, (GLuint program, GLint location, GLint v0), (program, location, v0)) \
+	F(void, ProgramUniform2fv, (GLuint program, GLint location, GLsizei count, const GLfloat* value), (program, location, count, value)) \
+	F(void, ProgramUniform3fv, (GLuint program, GLint location, GLsizei count, const GLfloat* value), (program, location, count, value)) \
+	F(void, ProgramUniform4fv, (GLuint program, GLint location, GLsizei count, const GLfloat* value), (program, location, count, value)) \
+	F(void, QueryCounter, (GLuint id, GLenum target), (id, target)) \
+	F(void, ReadPixels, (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels), (x, y, width, height, format, type, pixels)) \
+	F(void, SamplerParameterf, (GLuint sampler, GLenum pname, GLfloat param), (sampler, pname, param)) \
+	F(void, SamplerParameteri, (GLuint sampler, GLenum pname, GLint param), (sampler, pname, param)) \
+	F(void, Scissor, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height)) \
+	F(void, ShaderSource, (GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length), (shader, count, string, length)) \
+	F(void, StencilFunc, (GLenum func, GLint ref, GLuint mask), (func, ref, mask)) \
+	F(void, StencilMask, (GLuint mask), (mask)) \
+	F(void, StencilOp, (GLenum fail, GLenum zfail, GLenum zpass), (fail, zfail, zpass)) \
+	F(void, StringMarkerGREMEDY, (GLsizei len, const void* string), (len, string)) \
+	F(void, TexImage1D, (GLenum target, GLint level, GLint internalFormat, GLsizei width, GLint border, GLenum format, GLenum type, const void* pixels), (target, level, internalFormat, width, border, format, type, pixels)) \
+	F(void, TexImage2D, (GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels), (target, level, internalFormat, width, height, border, format, type, pixels)) \
+	F(void, TexImage3D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels), (target, level, internalformat, width, height, depth, border, format, type, pixels)) \
+	F(void, TexParameterf, (GLenum target, GLenum pname, GLfloat param), (target, pname, param)) \
+	F(void, TexParameteri, (GLenum target, GLenum pname, GLint param), (target, pname, param)) \
+	F(void, TextureParameterf, (GLuint texture, GLenum pname, GLfloat param), (texture, pname, param)) \
+	F(void, TextureParameteri, (GLuint texture, GLenum pname, GLint param), (texture, pname, param)) \
+	F(void, TextureStorage1D, (GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width), (texture, levels, internalformat, width)) \
+	F(void, TextureStorage2D, (GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height), (texture, levels, internalformat, width, height)) \
+	F(void, TextureStorage3D, (GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth), (texture, levels, internalformat, width, height, depth)) \
+	F(void, TextureSubImage1D, (GLuint texture, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const void* pixels), (texture, level, xoffset, width, format, type, pixels)) \
+	F(void, TextureSubImage2D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels), (texture, level, xoffset, yoffset, width, height, format, type, pixels)) \
+	F(void, TextureSubImage3D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels), (texture, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels)) \
+	F(void, Uniform1f, (GLint location, GLfloat v0), (location, v0)) \
+	F(void, Uniform1fv, (GLint location, GLsizei count, const GLfloat* value), (location, count, value)) \
+	F(void, Uniform1i, (GLint location, GLint v0), (location, v0)) \
+	F(void, Uniform2fv, (GLint location, GLsizei count, const GLfloat* value), (location, count, value)) \
+	F(void, Uniform3fv, (GLint location, GLsizei count, const GLfloat* value), (location, count, value)) \
+	F(void, Uniform4fv, (GLint location, GLsizei count, const GLfloat* value), (location, count, value)) \
+	F(GLboolean, UnmapBufferARB, (GLenum target), (target)) \
+	F(GLboolean, UnmapNamedBuffer, (GLuint buffer), (buffer)) \
+	F(void, UseProgram, (GLuint program), (program)) \
+	F(void, ValidateProgram, (GLuint program), (program)) \
+	F(void, VertexAttribDivisor, (GLuint index, GLuint divisor), (index, divisor)) \
+	F(void, VertexAttribPointer, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer), (index, size, type, normalized, stride, pointer)) \
+	F(void, Viewport, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height))
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+enum DispatchFunction
+{
+#define SPARKPLUG_GL_ENUM_ENTRY(R, Name, Params, Args) DispatchFunction_##Name,
+	SPARKPLUG_GL_FUNCTIONS(SPARKPLUG_GL_ENUM_ENTRY)
+#undef SPARKPLUG_GL_ENUM_ENTRY
+	DispatchFunction_Count
+};
+const char* AsString( DispatchFunction function );
+
+
+/**
+ * Table through which the library calls OpenGL.
+ * See Context::gl().
+ */
+class Dispatch
+{
+public:
+	virtual ~Dispatch();
+
+	/**
+	 * Whether an extension or core version is available,
+	 * named like "GL_ARB_sync" or "GL_VERSION_3_2".
+	 * Not a GL call, so interceptors don't see it.
+	 */
+	virtual bool isSupported( const char* name ) = 0;
+
+#define SPARKPLUG_GL_DECLARE(R, Name, Params, Args) virtual R Name Params = 0;
+	SPARKPLUG_GL_FUNCTIONS(SPARKPLUG_GL_DECLARE)
+#undef SPARKPLUG_GL_DECLARE
+};
+
+/**
+ * Calls the driver.
+ */
+class DriverDispatch : public Dispatch
+{
+public:
+	DriverDispatch();
+
+	/**
+	 * Copies the function pointers which GLEW loaded.
+	 * Unsupported functions stay NULL, so check the extension before calling them.
+	 */
+	void load();
+
+	virtual bool isSupported( const char* name );
+
+#define SPARKPLUG_GL_DECLARE(R, Name, Params, Args) R Name Params;
+	SPARKPLUG_GL_FUNCTIONS(SPARKPLUG_GL_DECLARE)
+#undef SPARKPLUG_GL_DECLARE
+
+private:
+#define SPARKPLUG_GL_DECLARE(R, Name, Params, Args) R (GLAPIENTRY *m_##Name) Params;
+	SPARKPLUG_GL_FUNCTIONS(SPARKPLUG_GL_DECLARE)
+#undef SPARKPLUG_GL_DECLARE
+};
+
+/**
+ * Passes every call on to the next dispatch in the chain.
+ * Derived classes implement beginCall() and endCall() to watch all calls,
+ * or override single functions to capture their arguments.
+ * Overrides should forward to Interceptor::Name() to keep the chain intact.
+ *
+ * See Context::addInterceptor().
+ */
+class Interceptor : public Dispatch
+{
+public:
+	Interceptor();
+	virtual ~Interceptor();
+
+	/**
+	 * NULL while the interceptor isn't part of a chain.
+	 */
+	Dispatch* next() const;
+
+	virtual bool isSupported( const char* name );
+
+#define SPARKPLUG_GL_DECLARE(R, Name, Params, Args) virtual R Name Params;
+	SPARKPLUG_GL_FUNCTIONS(SPARKPLUG_GL_DECLARE)
+#undef SPARKPLUG_GL_DECLARE
+
+protected:
+	virtual void beginCall( DispatchFunction function );
+	virtual void endCall( DispatchFunction function );
+
+private:
+	Interceptor( const Interceptor& source );
+	Interceptor& operator = ( const Interceptor& source );
+
+	class CallScope
+	{
+	public:
+		CallScope( Interceptor* interceptor, DispatchFunction function );
+		~CallScope();
+
+	private:
+		Interceptor* m_Interceptor;
+		DispatchFunction m_Function;
+	};
+
+	friend class Context;
+	Dispatch* m_Next;
+};
+
+/**
+ * Logs the name of every call.
+ */
+class CallTracer : public Interceptor
+{
+protected:
+	virtual void beginCall( DispatchFunction function );
+};
+
+/**
+ * Counts the calls of each function.
+ * Redundant state changes show up as unexpectedly high counts.
+ */
+class CallCounter : public Interceptor
+{
+public:
+	CallCounter();
+
+	int count( DispatchFunction function ) const;
+	int totalCount() const;
+
+	void reset();
+
+	/**
+	 * Logs the count of every called function.
+	 */
+	void print() const;
+
+protected:
+	virtual void beginCall( DispatchFunction function );
+
+private:
+	int m_Counts[DispatchFunction_Count];
+};
+
+/**
+ * Sums up the CPU time spent inside each function.
+ * Includes the time of interceptors further down the chain.
+ */
+class CallTimer : public Interceptor
+{
+public:
+	CallTimer();
+
+	double milliseconds( DispatchFunction function ) const;
+
+	void reset();
+
+	/**
+	 * Logs the time of every called function.
+	 */
+	void print() const;
+
+protected:
+	virtual void beginCall( DispatchFunction function );
+	virtual void endCall( DispatchFunction function );
+
+private:
+	unsigned long long m_Begin; // Nanoseconds
+	unsigned long long m_Nanoseconds[DispatchFunction_Count];
+};
+
+}
+}
+
+#endif
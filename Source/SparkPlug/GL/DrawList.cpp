@@ -0,0 +1,122 @@
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/DrawList.h>
+#include <SparkPlug/GL/Hash.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/// ---- Utils ----
+
+template<class T>
+unsigned long long KeyHandle( Handle<T> handle )
+{
+	return handle.value() & 0xFFFF;
+}
+
+
+/// ---- DrawCommand ----
+
+DrawCommand::DrawCommand() :
+	primitive(PrimitiveType_TriangleList),
+	first(0),
+	count(0)
+{
+}
+
+unsigned long long DrawCommand::sortKey() const
+{
+	// Commands which use the same texture set land in the same bucket.
+	unsigned int textureHash = HashSeed;
+	for(int i = 0; i < MaxTextures; ++i)
+		textureHash = Hash(textureHash, textures[i].value());
+	textureHash = (textureHash ^ (textureHash >> 16)) & 0xFFFF;
+
+	return
+		(KeyHandle(program) << 48) |
+		((unsigned long long)textureHash << 32) |
+		(KeyHandle(vertexBuffer) << 16) |
+		KeyHandle(indexBuffer);
+}
+
+
+/// ---- DrawList ----
+
+DrawList::DrawList() :
+	m_Sorted(true)
+{
+}
+
+void DrawList::submit( const DrawCommand& command )
+{
+	Entry entry;
+	entry.key = command.sortKey();
+	entry.index = m_Commands.size();
+
+	m_Commands.push_back(command);
+	m_Order.push_back(entry);
+	m_Sorted = false;
+}
+
+void DrawList::clear()
+{
+	m_Commands.clear();
+	m_Order.clear();
+	m_Sorted = true;
+}
+
+int DrawList::size() const
+{
+	return m_Commands.size();
+}
+
+bool DrawList::empty() const
+{
+	return m_Commands.empty();
+}
+
+void DrawList::sort()
+{
+	if(m_Sorted)
+		return;
+
+	// LSD radix sort, one byte per pass
+	const int count = m_Order.size();
+	m_Scratch.resize(count);
+
+	for(int shift = 0; shift < 64; shift += 8)
+	{
+		int offsets[256] = {0};
+		for(int i = 0; i < count; ++i)
+			++offsets[(m_Order[i].key >> shift) & 0xFF];
+
+		// All keys share this byte, so the pass wouldn't change anything.
+		if(offsets[(m_Order[0].key >> shift) & 0xFF] == count)
+			continue;
+
+		int sum = 0;
+		for(int i = 0; i < 256; ++i)
+		{
+			int bucketSize = offsets[i];
+			offsets[i] = sum;
+			sum += bucketSize;
+		}
+
+		for(int i = 0; i < count; ++i)
+			m_Scratch[offsets[(m_Order[i].key >> shift) & 0xFF]++] = m_Order[i];
+
+		m_Order.swap(m_Scratch);
+	}
+
+	m_Sorted = true;
+}
+
+const DrawCommand& DrawList::command( int i ) const
+{
+	assert(InsideArray(i, size()));
+	return m_Commands[m_Order[i].index];
+}
+
+}
+}
@@ -0,0 +1,98 @@
+#ifndef __SPARKPLUG_GL_DRAW_LIST__
+#define __SPARKPLUG_GL_DRAW_LIST__
+
+#include <vector>
+#include <SparkPlug/Reference.h>
+#include <SparkPlug/GL/Enums.h>
+#include <SparkPlug/GL/Texture.h>
+#include <SparkPlug/GL/Shader.h>
+#include <SparkPlug/GL/Buffer.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/**
+ * Everything needed for a single draw call.
+ * Without an index buffer first and count refer to vertices,
+ * otherwise to indices.
+ *
+ * Objects are referenced by handle, so copying and sorting commands
+ * doesn't touch the objects. Unlike references, handles don't keep
+ * them alive: the owner must hold on to the objects until the commands
+ * are executed. Breaking that is a bug, which asserts in debug builds.
+ * Release builds skip the command with a warning,
+ * see Context::bindDrawState().
+ */
+class DrawCommand
+{
+public:
+	static const int MaxTextures = 8;
+
+	DrawCommand();
+
+	/**
+	 * 64 bit key which sorts commands with equal state next to each other.
+	 * From the most to the least significant bits:
+	 * program, textures, vertex buffer, index buffer (16 bits each).
+	 * Handles which share their lower bits only cost an extra state switch.
+	 */
+	unsigned long long sortKey() const;
+
+	Handle<Program>      program;
+	Handle<Texture>      textures[MaxTextures]; // Index is the texture unit, units without one keep their texture
+	Handle<VertexBuffer> vertexBuffer;
+	Handle<IndexBuffer>  indexBuffer;
+
+	PrimitiveType primitive;
+	int first;
+	int count;
+};
+
+/**
+ * Collects draw commands, so they can be executed in an order
+ * which needs as few state changes as possible.
+ * See Context::execute().
+ */
+class DrawList
+{
+public:
+	DrawList();
+
+	void submit( const DrawCommand& command );
+	void clear();
+
+	int size() const;
+	bool empty() const;
+
+	/**
+	 * Sorts the commands by their sort key.
+	 * Commands with equal keys keep their submission order.
+	 */
+	void sort();
+
+	/**
+	 * Returns the i-th command in sorted order,
+	 * or in submission order if sort() wasn't called since the last submit().
+	 */
+	const DrawCommand& command( int i ) const;
+
+private:
+	struct Entry
+	{
+		unsigned long long key;
+		int index;
+	};
+
+	std::vector<DrawCommand> m_Commands;
+	std::vector<Entry> m_Order;
+	std::vector<Entry> m_Scratch;
+	bool m_Sorted;
+};
+
+}
+}
+
+#endif
@@ -206,6 +206,186 @@ GLenum ConvertToGL( ShaderType type )
 }
 
 
+/// Pipeline State ///
+
+const char* AsString( CompareFunction function )
+{
+	switch(function)
+	{
+		case CompareFunction_Never: return "Never";
+		case CompareFunction_Less: return "Less";
+		case CompareFunction_Equal: return "Equal";
+		case CompareFunction_LessEqual: return "LessEqual";
+		case CompareFunction_Greater: return "Greater";
+		case CompareFunction_NotEqual: return "NotEqual";
+		case CompareFunction_GreaterEqual: return "GreaterEqual";
+		case CompareFunction_Always: return "Always";
+	}
+	return "UnknownCompareFunction";
+}
+
+GLenum ConvertToGL( CompareFunction function )
+{
+	switch(function)
+	{
+		case CompareFunction_Never: return GL_NEVER;
+		case CompareFunction_Less: return GL_LESS;
+		case CompareFunction_Equal: return GL_EQUAL;
+		case CompareFunction_LessEqual: return GL_LEQUAL;
+		case CompareFunction_Greater: return GL_GREATER;
+		case CompareFunction_NotEqual: return GL_NOTEQUAL;
+		case CompareFunction_GreaterEqual: return GL_GEQUAL;
+		case CompareFunction_Always: return GL_ALWAYS;
+	}
+	FatalError("Invalid compare function: %u", function);
+	return 0;
+}
+
+const char* AsString( BlendFactor factor )
+{
+	switch(factor)
+	{
+		case BlendFactor_Zero: return "Zero";
+		case BlendFactor_One: return "One";
+		case BlendFactor_SourceColor: return "SourceColor";
+		case BlendFactor_InverseSourceColor: return "InverseSourceColor";
+		case BlendFactor_SourceAlpha: return "SourceAlpha";
+		case BlendFactor_InverseSourceAlpha: return "InverseSourceAlpha";
+		case BlendFactor_DestinationColor: return "DestinationColor";
+		case BlendFactor_InverseDestinationColor: return "InverseDestinationColor";
+		case BlendFactor_DestinationAlpha: return "DestinationAlpha";
+		case BlendFactor_InverseDestinationAlpha: return "InverseDestinationAlpha";
+	}
+	return "UnknownBlendFactor";
+}
+
+GLenum ConvertToGL( BlendFactor factor )
+{
+	switch(factor)
+	{
+		case BlendFactor_Zero: return GL_ZERO;
+		case BlendFactor_One: return GL_ONE;
+		case BlendFactor_SourceColor: return GL_SRC_COLOR;
+		case BlendFactor_InverseSourceColor: return GL_ONE_MINUS_SRC_COLOR;
+		case BlendFactor_SourceAlpha: return GL_SRC_ALPHA;
+		case BlendFactor_InverseSourceAlpha: return GL_ONE_MINUS_SRC_ALPHA;
+		case BlendFactor_DestinationColor: return GL_DST_COLOR;
+		case BlendFactor_InverseDestinationColor: return GL_ONE_MINUS_DST_COLOR;
+		case BlendFactor_DestinationAlpha: return GL_DST_ALPHA;
+		case BlendFactor_InverseDestinationAlpha: return GL_ONE_MINUS_DST_ALPHA;
+	}
+	FatalError("Invalid blend factor: %u", factor);
+	return 0;
+}
+
+const char* AsString( BlendOperation operation )
+{
+	switch(operation)
+	{
+		case BlendOperation_Add: return "Add";
+		case BlendOperation_Subtract: return "Subtract";
+		case BlendOperation_ReverseSubtract: return "ReverseSubtract";
+		case BlendOperation_Min: return "Min";
+		case BlendOperation_Max: return "Max";
+	}
+	return "UnknownBlendOperation";
+}
+
+GLenum ConvertToGL( BlendOperation operation )
+{
+	switch(operation)
+	{
+		case BlendOperation_Add: return GL_FUNC_ADD;
+		case BlendOperation_Subtract: return GL_FUNC_SUBTRACT;
+		case BlendOperation_ReverseSubtract: return GL_FUNC_REVERSE_SUBTRACT;
+		case BlendOperation_Min: return GL_MIN;
+		case BlendOperation_Max: return GL_MAX;
+	}
+	FatalError("Invalid blend operation: %u", operation);
+	return 0;
+}
+
+const char* AsString( StencilOperation operation )
+{
+	switch(operation)
+	{
+		case StencilOperation_Keep: return "Keep";
+		case StencilOperation_Zero: return "Zero";
+		case StencilOperation_Replace: return "Replace";
+		case StencilOperation_Increment: return "Increment";
+		case StencilOperation_Decrement: return "Decrement";
+		case StencilOperation_IncrementWrap: return "IncrementWrap";
+		case StencilOperation_DecrementWrap: return "DecrementWrap";
+		case StencilOperation_Invert: return "Invert";
+	}
+	return "UnknownStencilOperation";
+}
+
+GLenum ConvertToGL( StencilOperation operation )
+{
+	switch(operation)
+	{
+		case StencilOperation_Keep: return GL_KEEP;
+		case StencilOperation_Zero: return GL_ZERO;
+		case StencilOperation_Replace: return GL_REPLACE;
+		case StencilOperation_Increment: return GL_INCR;
+		case StencilOperation_Decrement: return GL_DECR;
+		case StencilOperation_IncrementWrap: return GL_INCR_WRAP;
+		case StencilOperation_DecrementWrap: return GL_DECR_WRAP;
+		case StencilOperation_Invert: return GL_INVERT;
+	}
+	FatalError("Invalid stencil operation: %u", operation);
+	return 0;
+}
+
+const char* AsString( CullMode mode )
+{
+	switch(mode)
+	{
+		case CullMode_None: return "None";
+		case CullMode_Front: return "Front";
+		case CullMode_Back: return "Back";
+	}
+	return "UnknownCullMode";
+}
+
+GLenum ConvertToGL( CullMode mode )
+{
+	switch(mode)
+	{
+		case CullMode_Front: return GL_FRONT;
+		case CullMode_Back: return GL_BACK;
+		case CullMode_None: ;
+	}
+	FatalError("Invalid cull mode: %u", mode);
+	return 0;
+}
+
+const char* AsString( FillMode mode )
+{
+	switch(mode)
+	{
+		case FillMode_Point: return "Point";
+		case FillMode_Wireframe: return "Wireframe";
+		case FillMode_Solid: return "Solid";
+	}
+	return "UnknownFillMode";
+}
+
+GLenum ConvertToGL( FillMode mode )
+{
+	switch(mode)
+	{
+		case FillMode_Point: return GL_POINT;
+		case FillMode_Wireframe: return GL_LINE;
+		case FillMode_Solid: return GL_FILL;
+	}
+	FatalError("Invalid fill mode: %u", mode);
+	return 0;
+}
+
+
+
 /// Debug ///
 
 const char* AsString( DebugEventSource source )
@@ -268,6 +448,7 @@ const char* AsString( DebugEventType type )
 		case DebugEventType_Portability: return "portability";
 		case DebugEventType_Performance: return "performance";
 		case DebugEventType_Other: return "other";
+		case DebugEventType_Count: ;
 	}
 	return "unknown";
 }
@@ -283,6 +464,7 @@ GLenum ConvertToGL( DebugEventType type )
 		case DebugEventType_Portability: return GL_DEBUG_TYPE_PORTABILITY_ARB;
 		case DebugEventType_Performance: return GL_DEBUG_TYPE_PERFORMANCE_ARB;
 		case DebugEventType_Other: return GL_DEBUG_TYPE_OTHER_ARB;
+		case DebugEventType_Count: ;
 	}
 #endif
 	FatalError("Invalid debug event type: %u", type);
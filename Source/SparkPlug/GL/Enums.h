@@ -68,6 +68,82 @@ const char* AsString( ShaderType type );
 GLenum      ConvertToGL( ShaderType type );
 
 
+/// Pipeline State ///
+
+enum CompareFunction
+{
+	CompareFunction_Never,
+	CompareFunction_Less,
+	CompareFunction_Equal,
+	CompareFunction_LessEqual,
+	CompareFunction_Greater,
+	CompareFunction_NotEqual,
+	CompareFunction_GreaterEqual,
+	CompareFunction_Always
+};
+const char* AsString( CompareFunction function );
+GLenum ConvertToGL( CompareFunction function );
+
+enum BlendFactor
+{
+	BlendFactor_Zero,
+	BlendFactor_One,
+	BlendFactor_SourceColor,
+	BlendFactor_InverseSourceColor,
+	BlendFactor_SourceAlpha,
+	BlendFactor_InverseSourceAlpha,
+	BlendFactor_DestinationColor,
+	BlendFactor_InverseDestinationColor,
+	BlendFactor_DestinationAlpha,
+	BlendFactor_InverseDestinationAlpha
+};
+const char* AsString( BlendFactor factor );
+GLenum ConvertToGL( BlendFactor factor );
+
+enum BlendOperation
+{
+	BlendOperation_Add,
+	BlendOperation_Subtract,
+	BlendOperation_ReverseSubtract,
+	BlendOperation_Min,
+	BlendOperation_Max
+};
+const char* AsString( BlendOperation operation );
+GLenum ConvertToGL( BlendOperation operation );
+
+enum StencilOperation
+{
+	StencilOperation_Keep,
+	StencilOperation_Zero,
+	StencilOperation_Replace,
+	StencilOperation_Increment,
+	StencilOperation_Decrement,
+	StencilOperation_IncrementWrap,
+	StencilOperation_DecrementWrap,
+	StencilOperation_Invert
+};
+const char* AsString( StencilOperation operation );
+GLenum ConvertToGL( StencilOperation operation );
+
+enum CullMode
+{
+	CullMode_None,
+	CullMode_Front,
+	CullMode_Back
+};
+const char* AsString( CullMode mode );
+GLenum ConvertToGL( CullMode mode );
+
+enum FillMode
+{
+	FillMode_Point,
+	FillMode_Wireframe,
+	FillMode_Solid
+};
+const char* AsString( FillMode mode );
+GLenum ConvertToGL( FillMode mode );
+
+
 /// Debug ///
 enum DebugEventSource
 {
@@ -90,7 +166,8 @@ enum DebugEventType
 	DebugEventType_UndefinedBahavior,
 	DebugEventType_Portability,
 	DebugEventType_Performance,
-	DebugEventType_Other
+	DebugEventType_Other,
+	DebugEventType_Count
 };
 const char* AsString( DebugEventType type );
 GLenum ConvertToGL( DebugEventType type );
@@ -0,0 +1,86 @@
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/Context.h>
+#include <SparkPlug/GL/Fence.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/// ---- Fence ----
+
+Fence::Fence( Context* context ) :
+	m_Context(context),
+	m_Sync(NULL)
+{
+}
+
+Fence::~Fence()
+{
+	// The owner may be destroyed on another thread.
+	m_Context->m_DeletionQueue.pushSync(m_Sync);
+}
+
+void Fence::release()
+{
+	if(m_Sync)
+	{
+		m_Context->gl().DeleteSync(m_Sync);
+		m_Sync = NULL;
+	}
+}
+
+void Fence::insert()
+{
+	release();
+
+	if(m_Context->m_UseSync)
+	{
+		m_Sync = m_Context->gl().FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_Context->gl().Flush();
+	}
+	else
+	{
+		m_Context->gl().Finish();
+	}
+}
+
+bool Fence::isSignaled()
+{
+	if(!m_Sync)
+		return true;
+
+	GLenum result = m_Context->gl().ClientWaitSync(m_Sync, 0, 0);
+	if(result == GL_TIMEOUT_EXPIRED)
+		return false;
+	if(result == GL_WAIT_FAILED)
+		LogError("Waiting for a fence failed.");
+
+	release();
+	return true;
+}
+
+void Fence::wait()
+{
+	if(!m_Sync)
+		return;
+
+	const GLuint64 timeout = 1000000000; // Nanoseconds
+	GLenum result = m_Context->gl().ClientWaitSync(m_Sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+	while(result == GL_TIMEOUT_EXPIRED)
+		result = m_Context->gl().ClientWaitSync(m_Sync, 0, timeout);
+	if(result == GL_WAIT_FAILED)
+		LogError("Waiting for a fence failed.");
+
+	release();
+}
+
+void Fence::moveTo( Context* context )
+{
+	if(!context->sharesObjectsWith(m_Context))
+		FatalError("Fences can only be moved between contexts which share them.");
+	m_Context = context;
+}
+
+}
+}
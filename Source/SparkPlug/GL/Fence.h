@@ -0,0 +1,69 @@
+#ifndef __SPARKPLUG_GL_FENCE__
+#define __SPARKPLUG_GL_FENCE__
+
+#include <SparkPlug/GL/OpenGL.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+class Context;
+
+/**
+ * Marks a point in the command stream of a context.
+ * It is signaled when the GPU has finished all commands before it.
+ * Fences are shared between contexts of a share group.
+ *
+ * Without ARB_sync insert() waits for all commands to finish,
+ * so the fence is signaled right away.
+ */
+class Fence
+{
+public:
+	Fence( Context* context );
+
+	/**
+	 * May run on any thread, the sync object is deleted
+	 * through the deletion queue of the context.
+	 */
+	~Fence();
+
+	/**
+	 * Replaces the previous fence.
+	 * Flushes the context, so other contexts can wait for it.
+	 */
+	void insert();
+
+	/**
+	 * Never blocks.
+	 * A fence which was never inserted counts as signaled.
+	 */
+	bool isSignaled();
+
+	/**
+	 * Blocks until the fence is signaled.
+	 */
+	void wait();
+
+	/**
+	 * Contexts of the same share group only.
+	 * The fence is checked through the new context from now on.
+	 */
+	void moveTo( Context* context );
+
+private:
+	Fence( const Fence& source );
+	Fence& operator = ( const Fence& source );
+
+	void release();
+
+	Context* m_Context;
+	GLsync   m_Sync;
+};
+
+}
+}
+
+#endif
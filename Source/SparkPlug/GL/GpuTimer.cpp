@@ -0,0 +1,155 @@
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/Context.h>
+#include <SparkPlug/GL/GpuTimer.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/// ---- GpuTimer ----
+
+GpuTimer::GpuTimer( Context* context ) :
+	m_Context(context),
+	m_Frame(0),
+	m_Depth(0)
+{
+}
+
+GpuTimer::~GpuTimer()
+{
+	for(int i = 0; i < FrameLatency; ++i)
+	{
+		std::vector<Zone>::const_iterator zone = m_Frames[i].begin();
+		for(; zone != m_Frames[i].end(); ++zone)
+		{
+			m_FreeQueries.push_back(zone->begin);
+			if(zone->end)
+				m_FreeQueries.push_back(zone->end);
+		}
+	}
+
+	if(!m_FreeQueries.empty())
+		m_Context->gl().DeleteQueries(m_FreeQueries.size(), &m_FreeQueries[0]);
+}
+
+GLuint GpuTimer::acquireQuery()
+{
+	if(m_FreeQueries.empty())
+	{
+		GLuint query = 0;
+		m_Context->gl().GenQueries(1, &query);
+		return query;
+	}
+
+	GLuint query = m_FreeQueries.back();
+	m_FreeQueries.pop_back();
+	return query;
+}
+
+int GpuTimer::beginZone( const char* name )
+{
+	Zone zone;
+	zone.name  = name;
+	zone.depth = m_Depth++;
+	zone.begin = acquireQuery();
+	zone.end   = 0;
+	m_Context->gl().QueryCounter(zone.begin, GL_TIMESTAMP);
+
+	std::vector<Zone>& zones = m_Frames[m_Frame];
+	zones.push_back(zone);
+	return zones.size()-1;
+}
+
+void GpuTimer::endZone( int zone )
+{
+	std::vector<Zone>& zones = m_Frames[m_Frame];
+	assert(InsideArray(zone, (int)zones.size()));
+	assert(zones[zone].end == 0);
+
+	zones[zone].end = acquireQuery();
+	m_Context->gl().QueryCounter(zones[zone].end, GL_TIMESTAMP);
+	--m_Depth;
+}
+
+void GpuTimer::endFrame()
+{
+	if(m_Depth != 0)
+		LogWarning("GpuTimer: %d zones are still open at the end of the frame.", m_Depth);
+
+	m_Frame = (m_Frame+1) % FrameLatency;
+	collect(m_Frames[m_Frame]);
+}
+
+void GpuTimer::collect( std::vector<Zone>& zones )
+{
+	if(zones.empty())
+		return;
+
+	// Queries complete in order, so the last one tells about all of them.
+	GLuint last = zones.back().end ? zones.back().end : zones.back().begin;
+	GLint available = GL_FALSE;
+	m_Context->gl().GetQueryObjectiv(last, GL_QUERY_RESULT_AVAILABLE, &available);
+
+	if(available)
+	{
+		m_Results.clear();
+		std::vector<Zone>::const_iterator zone = zones.begin();
+		for(; zone != zones.end(); ++zone)
+		{
+			if(!zone->end)
+				continue;
+
+			GLuint64 begin = 0;
+			GLuint64 end   = 0;
+			m_Context->gl().GetQueryObjectui64v(zone->begin, GL_QUERY_RESULT, &begin);
+			m_Context->gl().GetQueryObjectui64v(zone->end, GL_QUERY_RESULT, &end);
+
+			GpuTimerResult result;
+			result.name  = zone->name;
+			result.depth = zone->depth;
+			result.milliseconds = double(end-begin) / 1000000.0;
+			m_Results.push_back(result);
+		}
+	}
+	else
+	{
+		// Waiting would stall, so the frame is dropped and the previous results stay.
+		// Normal for a busy GPU, so it's only counted.
+		++m_Context->m_Stats.gpuTimerFramesDropped;
+	}
+
+	std::vector<Zone>::const_iterator zone = zones.begin();
+	for(; zone != zones.end(); ++zone)
+	{
+		m_FreeQueries.push_back(zone->begin);
+		if(zone->end)
+			m_FreeQueries.push_back(zone->end);
+	}
+	zones.clear();
+}
+
+const std::vector<GpuTimerResult>& GpuTimer::results() const
+{
+	return m_Results;
+}
+
+
+/// ---- GpuTimerScope ----
+
+GpuTimerScope::GpuTimerScope( Context* context, const char* name ) :
+	m_Timer(context->gpuTimer()),
+	m_Zone(-1)
+{
+	if(m_Timer)
+		m_Zone = m_Timer->beginZone(name);
+}
+
+GpuTimerScope::~GpuTimerScope()
+{
+	if(m_Timer)
+		m_Timer->endZone(m_Zone);
+}
+
+}
+}
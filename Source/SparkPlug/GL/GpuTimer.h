@@ -0,0 +1,99 @@
+#ifndef __SPARKPLUG_GL_GPU_TIMER__
+#define __SPARKPLUG_GL_GPU_TIMER__
+
+#include <vector>
+#include <SparkPlug/GL/OpenGL.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+class Context;
+
+class GpuTimerResult
+{
+public:
+	const char* name;
+	int depth; // Nesting level of the zone
+	double milliseconds;
+};
+
+/**
+ * Measures GPU time of nested zones with GL_TIMESTAMP queries.
+ * Results are read FrameLatency frames later,
+ * when the GPU has finished them, so reading never stalls.
+ * If it hasn't, the frame is dropped, see Statistics::gpuTimerFramesDropped.
+ * Query objects are pooled and reused.
+ *
+ * Zones must end in the frame they began.
+ * Their names are not copied, so use string literals.
+ */
+class GpuTimer
+{
+public:
+	static const int FrameLatency = 3;
+
+	GpuTimer( Context* context );
+	~GpuTimer();
+
+	int beginZone( const char* name );
+	void endZone( int zone );
+
+	/**
+	 * Advances the ring and collects the results
+	 * of the frame that was recorded FrameLatency frames ago.
+	 * Called by Context::endFrame().
+	 */
+	void endFrame();
+
+	/**
+	 * Zones of the latest frame whose results are available,
+	 * in the order they began.
+	 */
+	const std::vector<GpuTimerResult>& results() const;
+
+private:
+	GpuTimer( const GpuTimer& source );
+	GpuTimer& operator = ( const GpuTimer& source );
+
+	struct Zone
+	{
+		const char* name;
+		int depth;
+		GLuint begin;
+		GLuint end; // 0 while the zone is open
+	};
+
+	GLuint acquireQuery();
+	void collect( std::vector<Zone>& zones );
+
+	Context* m_Context;
+	std::vector<Zone> m_Frames[FrameLatency];
+	int m_Frame;
+	int m_Depth;
+
+	std::vector<GLuint> m_FreeQueries;
+	std::vector<GpuTimerResult> m_Results;
+};
+
+/**
+ * Times the GPU work issued during its lifetime.
+ * Does nothing if the context has no timer.
+ */
+class GpuTimerScope
+{
+	public:
+		GpuTimerScope( Context* context, const char* name );
+		virtual ~GpuTimerScope();
+
+	private:
+		GpuTimer* m_Timer;
+		int       m_Zone;
+};
+
+}
+}
+
+#endif
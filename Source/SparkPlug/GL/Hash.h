@@ -0,0 +1,45 @@
+#ifndef __SPARKPLUG_GL_HASH__
+#define __SPARKPLUG_GL_HASH__
+
+#include <cstring>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/**
+ * FNV-1a, for the state, vertex format and draw command hashes.
+ * Start with HashSeed and feed each value through Hash().
+ */
+const unsigned int HashSeed = 2166136261u;
+
+inline unsigned int Hash( unsigned int hash, unsigned int value )
+{
+	for(int i = 0; i < 4; ++i)
+	{
+		hash = (hash ^ (value & 0xFF)) * 16777619u;
+		value >>= 8;
+	}
+	return hash;
+}
+
+inline unsigned int Hash( unsigned int hash, float value )
+{
+	unsigned int bits = 0;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return Hash(hash, bits);
+}
+
+inline unsigned int Hash( unsigned int hash, const char* str )
+{
+	for(; *str != '\0'; ++str)
+		hash = (hash ^ (unsigned char)*str) * 16777619u;
+	return hash;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,234 @@
+#include <cstring>
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/HeadlessContext.h>
+
+#if defined(SPARKPLUG_GL_EGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+#if defined(SPARKPLUG_GL_EGL)
+
+/// ---- Utils ----
+
+bool HasExtension( const char* extensions, const char* name )
+{
+	if(!extensions)
+		return false;
+
+	const int length = std::strlen(name);
+	for(const char* i = std::strstr(extensions, name); i; i = std::strstr(i+length, name))
+	{
+		// Must match a whole word, not just a prefix.
+		if((i == extensions || i[-1] == ' ') && (i[length] == ' ' || i[length] == '\0'))
+			return true;
+	}
+	return false;
+}
+
+EGLDisplay OpenDisplay()
+{
+	const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+	if(HasExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+	{
+		PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+			(PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+		if(getPlatformDisplay)
+		{
+			EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+			if(display != EGL_NO_DISPLAY)
+				return display;
+		}
+	}
+	return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+
+/// ---- HeadlessContext ----
+
+HeadlessContext::HeadlessContext( int width, int height, HeadlessContext* shareWith ) :
+	m_Width(width),
+	m_Height(height),
+	m_Display(EGL_NO_DISPLAY),
+	m_Surface(EGL_NO_SURFACE),
+	m_Context(EGL_NO_CONTEXT),
+	m_OwnsDisplay(false)
+{
+	EGLDisplay display = EGL_NO_DISPLAY;
+	if(shareWith)
+	{
+		display = shareWith->m_Display;
+	}
+	else
+	{
+		display = OpenDisplay();
+		if(display == EGL_NO_DISPLAY)
+			FatalError("No EGL display available.");
+
+		EGLint major = 0, minor = 0;
+		if(!eglInitialize(display, &major, &minor))
+			FatalError("EGL init failed: 0x%x", eglGetError());
+		m_OwnsDisplay = true;
+		Log("EGL: %d.%d (%s)", major, minor, eglQueryString(display, EGL_VENDOR));
+	}
+	m_Display = display;
+
+	if(!eglBindAPI(EGL_OPENGL_API))
+		FatalError("EGL doesn't support desktop OpenGL.");
+
+	const EGLint configAttributes[] = {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8,
+		EGL_GREEN_SIZE, 8,
+		EGL_BLUE_SIZE, 8,
+		EGL_ALPHA_SIZE, 8,
+		EGL_DEPTH_SIZE, 24,
+		EGL_STENCIL_SIZE, 8,
+		EGL_NONE
+	};
+	EGLConfig config;
+	EGLint configCount = 0;
+	if(!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0)
+		FatalError("No EGL config with an offscreen framebuffer found.");
+
+	const EGLint surfaceAttributes[] = {
+		EGL_WIDTH, width,
+		EGL_HEIGHT, height,
+		EGL_NONE
+	};
+	m_Surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+	if(m_Surface == EGL_NO_SURFACE)
+		FatalError("EGL surface creation failed: 0x%x", eglGetError());
+
+	m_Context = eglCreateContext(display, config, shareWith ? shareWith->m_Context : EGL_NO_CONTEXT, NULL);
+	if(m_Context == EGL_NO_CONTEXT)
+		FatalError("EGL context creation failed: 0x%x", eglGetError());
+
+	// Restored below, so creating a shared context doesn't steal the thread.
+	EGLContext previousContext = eglGetCurrentContext();
+	EGLSurface previousDraw = eglGetCurrentSurface(EGL_DRAW);
+	EGLSurface previousRead = eglGetCurrentSurface(EGL_READ);
+
+	makeCurrent();
+
+	if(shareWith)
+		shareObjectsWith(shareWith);
+	postInit();
+
+	setViewport(0, 0, width, height);
+
+	if(shareWith)
+	{
+		if(previousContext != EGL_NO_CONTEXT)
+			eglMakeCurrent(display, previousDraw, previousRead, previousContext);
+		else
+			releaseCurrent();
+	}
+}
+
+HeadlessContext::~HeadlessContext()
+{
+	if(m_Display != EGL_NO_DISPLAY)
+	{
+		// shutdown() needs the context to be current on this thread.
+		// That fails if another thread still uses it, the names leak then.
+		EGLDisplay previousDisplay = eglGetCurrentDisplay();
+		EGLContext previousContext = eglGetCurrentContext();
+		EGLSurface previousDraw = eglGetCurrentSurface(EGL_DRAW);
+		EGLSurface previousRead = eglGetCurrentSurface(EGL_READ);
+
+		if(m_Context != EGL_NO_CONTEXT && previousContext != m_Context)
+		{
+			if(!eglMakeCurrent(m_Display, m_Surface, m_Surface, m_Context))
+				LogWarning("Can't make EGL context current for destruction: 0x%x", eglGetError());
+		}
+
+		if(eglGetCurrentContext() == m_Context)
+		{
+			shutdown();
+
+			if(previousContext != EGL_NO_CONTEXT && previousContext != m_Context)
+				eglMakeCurrent(previousDisplay, previousDraw, previousRead, previousContext);
+			else
+				releaseCurrent();
+		}
+
+		if(m_Context != EGL_NO_CONTEXT)
+			eglDestroyContext(m_Display, m_Context);
+		if(m_Surface != EGL_NO_SURFACE)
+			eglDestroySurface(m_Display, m_Surface);
+		if(m_OwnsDisplay)
+			eglTerminate(m_Display);
+	}
+}
+
+void HeadlessContext::makeCurrent()
+{
+	if(!eglMakeCurrent(m_Display, m_Surface, m_Surface, m_Context))
+		FatalError("Can't make EGL context current: 0x%x", eglGetError());
+}
+
+void HeadlessContext::releaseCurrent()
+{
+	eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
+#else
+
+HeadlessContext::HeadlessContext( int width, int height, HeadlessContext* shareWith ) :
+	m_Width(width),
+	m_Height(height),
+	m_Display(NULL),
+	m_Surface(NULL),
+	m_Context(NULL),
+	m_OwnsDisplay(false)
+{
+	FatalError("sparkplug-gl was built without EGL, so there is no headless context.");
+}
+
+HeadlessContext::~HeadlessContext()
+{
+}
+
+void HeadlessContext::makeCurrent()
+{
+}
+
+void HeadlessContext::releaseCurrent()
+{
+}
+
+#endif
+
+int HeadlessContext::width() const
+{
+	return m_Width;
+}
+
+int HeadlessContext::height() const
+{
+	return m_Height;
+}
+
+void HeadlessContext::readPixels( void* destination )
+{
+	// A bound pixel pack buffer would turn destination into an offset into it.
+	// The binding is restored lazily by the next commit.
+	const StrongRef<Buffer> packer = boundBuffer(BufferTarget_PixelPacker);
+	unbindBuffer(BufferTarget_PixelPacker);
+	commitBindings();
+
+	gl().ReadPixels(0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, destination);
+
+	if(packer)
+		bindBuffer(packer);
+}
+
+}
+}
@@ -0,0 +1,59 @@
+#ifndef __SPARKPLUG_GL_HEADLESS_CONTEXT__
+#define __SPARKPLUG_GL_HEADLESS_CONTEXT__
+
+#include <SparkPlug/GL/Context.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/**
+ * Context which renders into an offscreen default framebuffer.
+ * Needs no display server, just an EGL driver like Mesa's llvmpipe.
+ * Prefers the surfaceless platform and falls back to the default display.
+ *
+ * A context which shares objects with another one isn't left current,
+ * so it can be handed to a ResourceWorker.
+ *
+ * Only available if the library was built with EGL.
+ */
+class HeadlessContext : public Context
+{
+	public:
+		HeadlessContext( int width, int height, HeadlessContext* shareWith = NULL );
+		virtual ~HeadlessContext();
+
+		virtual void makeCurrent();
+		virtual void releaseCurrent();
+
+		int width() const;
+		int height() const;
+
+		/**
+		 * Reads the default framebuffer as RGBA with 8 bits per component,
+		 * bottom row first.
+		 * The destination needs room for width*height*4 bytes.
+		 * Pending draws and bindings are committed first.
+		 */
+		void readPixels( void* destination );
+
+	private:
+		HeadlessContext( const HeadlessContext& source );
+		HeadlessContext& operator = ( const HeadlessContext& source );
+
+		int m_Width;
+		int m_Height;
+
+		// EGL handles, kept opaque so EGL doesn't leak into the headers
+		void* m_Display;
+		void* m_Surface;
+		void* m_Context;
+		bool  m_OwnsDisplay; // Terminating it would break the contexts sharing it
+};
+
+}
+}
+
+#endif
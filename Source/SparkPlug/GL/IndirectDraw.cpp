@@ -0,0 +1,161 @@
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/Context.h>
+#include <SparkPlug/GL/IndirectDraw.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/// ---- Utils ----
+
+bool SameDrawState( const DrawCommand& a, const DrawCommand& b )
+{
+	if(a.program != b.program ||
+	   a.vertexBuffer != b.vertexBuffer ||
+	   a.indexBuffer != b.indexBuffer ||
+	   a.primitive != b.primitive)
+		return false;
+
+	for(int i = 0; i < DrawCommand::MaxTextures; ++i)
+		if(a.textures[i] != b.textures[i])
+			return false;
+	return true;
+}
+
+
+/// ---- IndirectDrawEngine ----
+
+IndirectDrawEngine::IndirectDrawEngine( Context* context ) :
+	m_Context(context),
+	m_DrawCount(0)
+{
+}
+
+Context* IndirectDrawEngine::context() const
+{
+	return m_Context;
+}
+
+void IndirectDrawEngine::add( const DrawCommand& command, int baseVertex, int instanceCount, int baseInstance )
+{
+	if(command.indexBuffer.isNull())
+		FatalError("IndirectDrawEngine only handles indexed draws.");
+	const Capabilities& capabilities = m_Context->capabilities();
+	if(baseInstance != 0 && !(capabilities.hasFeature(Feature_BaseInstance) && capabilities.hasFeature(Feature_DrawIndirect)))
+		FatalError("A non zero baseInstance needs ARB_base_instance and ARB_draw_indirect.");
+	if(baseVertex != 0 && !capabilities.hasFeature(Feature_DrawElementsBaseVertex))
+		FatalError("A non zero baseVertex needs ARB_draw_elements_base_vertex.");
+
+	DrawElementsIndirectCommand record;
+	record.count         = command.count;
+	record.instanceCount = instanceCount;
+	record.firstIndex    = command.first;
+	record.baseVertex    = baseVertex;
+	record.baseInstance  = baseInstance;
+
+	unsigned long long key = command.sortKey();
+
+	typedef std::multimap<unsigned long long, int>::const_iterator Iter;
+	std::pair<Iter, Iter> range = m_BatchIndices.equal_range(key);
+	for(Iter i = range.first; i != range.second; ++i)
+	{
+		Batch& batch = m_Batches[i->second];
+		if(SameDrawState(batch.state, command))
+		{
+			batch.records.push_back(record);
+			++m_DrawCount;
+			return;
+		}
+	}
+
+	m_BatchIndices.insert(std::make_pair(key, (int)m_Batches.size()));
+	m_Batches.push_back(Batch());
+	m_Batches.back().state = command;
+	m_Batches.back().records.push_back(record);
+	++m_DrawCount;
+}
+
+void IndirectDrawEngine::execute()
+{
+	if(m_Batches.empty())
+		return;
+
+	// Batches are drawn in sort key order, so neighbours share most state.
+	std::multimap<unsigned long long, int>::const_iterator i;
+	if(!m_Context->capabilities().hasFeature(Feature_DrawIndirect))
+	{
+		for(i = m_BatchIndices.begin(); i != m_BatchIndices.end(); ++i)
+		{
+			const Batch& batch = m_Batches[i->second];
+			if(m_Context->bindDrawState(batch.state))
+				drawRecords(batch);
+		}
+		clear();
+		return;
+	}
+
+	m_Records.clear();
+	for(i = m_BatchIndices.begin(); i != m_BatchIndices.end(); ++i)
+	{
+		const Batch& batch = m_Batches[i->second];
+		m_Records.insert(m_Records.end(), batch.records.begin(), batch.records.end());
+	}
+
+	if(!m_Buffer || m_Buffer->elementCount() < (int)m_Records.size())
+		m_Buffer = IndirectBuffer::Create(m_Context, m_Records.size(), BufferUsage_Stream);
+	m_Buffer->copyFrom(&m_Records[0], m_Records.size());
+
+	m_Context->bindBuffer(m_Buffer);
+
+	int first = 0;
+	for(i = m_BatchIndices.begin(); i != m_BatchIndices.end(); ++i)
+	{
+		const Batch& batch = m_Batches[i->second];
+		const int count = batch.records.size();
+
+		if(m_Context->bindDrawState(batch.state))
+			m_Context->drawElementsIndirect(batch.state.primitive, first, count);
+		first += count;
+	}
+
+	clear();
+}
+
+void IndirectDrawEngine::drawRecords( const Batch& batch )
+{
+	const PrimitiveType primitive = batch.state.primitive;
+	for(size_t i = 0; i < batch.records.size(); ++i)
+	{
+		const DrawElementsIndirectCommand& record = batch.records[i];
+		if(record.instanceCount == 0)
+			continue;
+
+		if(record.baseVertex != 0)
+			m_Context->drawElementsBaseVertex(primitive, record.firstIndex, record.count, record.baseVertex, record.instanceCount);
+		else if(record.instanceCount != 1)
+			m_Context->drawElementsInstanced(primitive, record.firstIndex, record.count, record.instanceCount);
+		else
+			m_Context->drawElements(primitive, record.firstIndex, record.count);
+	}
+}
+
+void IndirectDrawEngine::clear()
+{
+	m_Batches.clear();
+	m_BatchIndices.clear();
+	m_DrawCount = 0;
+}
+
+int IndirectDrawEngine::drawCount() const
+{
+	return m_DrawCount;
+}
+
+int IndirectDrawEngine::batchCount() const
+{
+	return m_Batches.size();
+}
+
+}
+}
@@ -0,0 +1,76 @@
+#ifndef __SPARKPLUG_GL_INDIRECT_DRAW__
+#define __SPARKPLUG_GL_INDIRECT_DRAW__
+
+#include <map>
+#include <vector>
+#include <SparkPlug/Reference.h>
+#include <SparkPlug/GL/Buffer.h>
+#include <SparkPlug/GL/DrawList.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+class Context;
+
+/**
+ * Packs indexed draws into DrawElementsIndirectCommand records.
+ * Draws which share program, textures, vertex buffer, index buffer
+ * and primitive type are issued with a single glMultiDrawElementsIndirect.
+ * Meshes that live in the same buffers are told apart
+ * by their first index and base vertex.
+ *
+ * Without ARB_draw_indirect the records stay on the CPU
+ * and are drawn one by one, still grouped by state.
+ */
+class IndirectDrawEngine
+{
+public:
+	IndirectDrawEngine( Context* context );
+
+	/**
+	 * command.first and command.count select the indices.
+	 * baseVertex is added to each index before fetching the vertex.
+	 * baseVertex must be 0 without ARB_draw_elements_base_vertex.
+	 * baseInstance must be 0 without ARB_base_instance and ARB_draw_indirect.
+	 */
+	void add( const DrawCommand& command, int baseVertex = 0, int instanceCount = 1, int baseInstance = 0 );
+
+	/**
+	 * Uploads the records of all batches into one indirect buffer
+	 * and draws each batch with a single call.
+	 * Clears the engine afterwards.
+	 */
+	void execute();
+
+	void clear();
+
+	int drawCount() const;
+	int batchCount() const;
+
+	Context* context() const;
+
+private:
+	struct Batch
+	{
+		DrawCommand state;
+		std::vector<DrawElementsIndirectCommand> records;
+	};
+
+	Context* m_Context;
+	std::vector<Batch> m_Batches;
+	std::multimap<unsigned long long, int> m_BatchIndices; // Sort key -> m_Batches index
+	int m_DrawCount;
+
+	void drawRecords( const Batch& batch );
+
+	std::vector<DrawElementsIndirectCommand> m_Records; // Upload staging
+	StrongRef<IndirectBuffer> m_Buffer; // Grows when needed
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/Context.h>
+#include <SparkPlug/GL/NamePool.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/// ---- NamePool ----
+
+NamePool::NamePool( Context* context ) :
+	m_Context(context)
+{
+}
+
+NamePool::~NamePool()
+{
+	release();
+}
+
+void NamePool::release()
+{
+	Dispatch& gl = m_Context->gl();
+	for(int i = 0; i < NameKind_Count; ++i)
+	{
+		const std::vector<GLuint>& names = m_Names[i];
+		if(names.empty())
+			continue;
+
+		if(i == NameKind_Buffer)
+			gl.DeleteBuffersARB(names.size(), &names[0]);
+		else if(i == NameKind_Sampler)
+			gl.DeleteSamplers(names.size(), &names[0]);
+		else
+			gl.DeleteTextures(names.size(), &names[0]);
+		m_Names[i].clear();
+	}
+}
+
+GLuint NamePool::acquire( NameKind kind )
+{
+	assert(InsideArray(kind, NameKind_Count));
+
+	std::vector<GLuint>& names = m_Names[kind];
+	if(names.empty())
+		refill(kind);
+
+	GLuint name = names.back();
+	names.pop_back();
+	return name;
+}
+
+void NamePool::refill( NameKind kind )
+{
+	Dispatch& gl = m_Context->gl();
+	std::vector<GLuint>& names = m_Names[kind];
+	names.resize(BlockSize);
+
+	if(kind == NameKind_Buffer)
+	{
+		if(m_Context->m_DirectStateAccess)
+			gl.CreateBuffers(BlockSize, &names[0]);
+		else
+			gl.GenBuffersARB(BlockSize, &names[0]);
+	}
+	else if(kind == NameKind_Sampler)
+	{
+		gl.GenSamplers(BlockSize, &names[0]);
+	}
+	else
+	{
+		TextureType type = TextureType(kind - NameKind_FirstTexture);
+		if(m_Context->m_DirectStateAccess)
+			gl.CreateTextures(ConvertToGL(type), BlockSize, &names[0]);
+		else
+			gl.GenTextures(BlockSize, &names[0]);
+	}
+
+	// Hand out the lowest names first.
+	std::reverse(names.begin(), names.end());
+}
+
+}
+}
@@ -0,0 +1,58 @@
+#ifndef __SPARKPLUG_GL_NAME_POOL__
+#define __SPARKPLUG_GL_NAME_POOL__
+
+#include <vector>
+#include <SparkPlug/GL/OpenGL.h>
+#include <SparkPlug/GL/Enums.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+class Context;
+
+enum NameKind
+{
+	NameKind_Buffer,
+	NameKind_Sampler,
+	NameKind_FirstTexture, // One kind for each TextureType, because of glCreateTextures
+	NameKind_Count = NameKind_FirstTexture + TextureType_Count
+};
+
+/**
+ * Reserves object names in blocks, so creating an object
+ * usually doesn't need a driver call.
+ * With direct state access the names are created objects already.
+ */
+class NamePool
+{
+public:
+	static const int BlockSize = 256;
+
+	NamePool( Context* context );
+
+	~NamePool();
+
+	/**
+	 * Deletes the names which weren't handed out.
+	 */
+	void release();
+
+	GLuint acquire( NameKind kind );
+
+private:
+	NamePool( const NamePool& source );
+	NamePool& operator = ( const NamePool& source );
+
+	void refill( NameKind kind );
+
+	Context* m_Context;
+	std::vector<GLuint> m_Names[NameKind_Count];
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,32 @@
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/NullContext.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+NullContext::NullContext() :
+	Context(new NullDispatch())
+{
+	postInit();
+}
+
+NullContext::NullContext( NullDispatch* backend ) :
+	Context(backend)
+{
+	postInit();
+}
+
+NullContext::~NullContext()
+{
+	shutdown();
+}
+
+NullDispatch& NullContext::nullDispatch()
+{
+	return *static_cast<NullDispatch*>(backend());
+}
+
+}
+}
@@ -0,0 +1,37 @@
+#ifndef __SPARKPLUG_GL_NULL_CONTEXT__
+#define __SPARKPLUG_GL_NULL_CONTEXT__
+
+#include <SparkPlug/GL/Context.h>
+#include <SparkPlug/GL/NullDispatch.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/**
+ * Context which doesn't need a window or a GPU.
+ * Useful to measure the CPU overhead of the library
+ * and to check which calls it makes.
+ */
+class NullContext : public Context
+{
+	public:
+		NullContext();
+
+		/**
+		 * Takes ownership of the backend.
+		 * Lets it be set up first, e.g. with more extensions.
+		 */
+		explicit NullContext( NullDispatch* backend );
+
+		virtual ~NullContext();
+
+		NullDispatch& nullDispatch();
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,397 @@
+#include <cstring>
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/NullDispatch.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/// ---- Utils ----
+
+/**
+ * Allows R() for every return type, including void and pointers.
+ */
+template<typename T>
+struct NullResult
+{
+	typedef T Type;
+};
+
+GLuint FirstName( GLsizei n, const GLuint* names )
+{
+	return (n > 0) ? names[0] : 0;
+}
+
+
+/// ---- NoOpDispatch ----
+
+NoOpDispatch::NoOpDispatch() :
+	m_Recording(true)
+{
+	for(int i = 0; i < DispatchFunction_Count; ++i)
+		m_Counts[i] = 0;
+}
+
+const std::vector<DispatchCall>& NoOpDispatch::calls() const
+{
+	return m_Calls;
+}
+
+int NoOpDispatch::callCount( DispatchFunction function ) const
+{
+	assert(InsideArray(function, DispatchFunction_Count));
+	return m_Counts[function];
+}
+
+void NoOpDispatch::clearCalls()
+{
+	m_Calls.clear();
+	for(int i = 0; i < DispatchFunction_Count; ++i)
+		m_Counts[i] = 0;
+}
+
+void NoOpDispatch::setRecording( bool enabled )
+{
+	m_Recording = enabled;
+}
+
+void NoOpDispatch::setSupported( const char* name, bool supported )
+{
+	if(supported)
+		m_Supported.insert(name);
+	else
+		m_Supported.erase(name);
+}
+
+bool NoOpDispatch::isSupported( const char* name )
+{
+	return m_Supported.count(name) != 0;
+}
+
+void NoOpDispatch::record( DispatchFunction function, GLenum target, GLuint name )
+{
+	++m_Counts[function];
+	if(m_Recording)
+	{
+		DispatchCall call;
+		call.function = function;
+		call.target = target;
+		call.name = name;
+		m_Calls.push_back(call);
+	}
+}
+
+#define SPARKPLUG_GL_DEFINE(R, Name, Params, Args) \
+	R NoOpDispatch::Name Params \
+	{ \
+		record(DispatchFunction_##Name); \
+		return NullResult<R>::Type(); \
+	}
+SPARKPLUG_GL_FUNCTIONS(SPARKPLUG_GL_DEFINE)
+#undef SPARKPLUG_GL_DEFINE
+
+
+/// ---- NullDispatch ----
+
+NullDispatch::NullDispatch() :
+	m_NextName(1)
+{
+	const char* versions[] = { "GL_VERSION_1_1", "GL_VERSION_1_2", "GL_VERSION_1_3", "GL_VERSION_1_4", "GL_VERSION_1_5", "GL_VERSION_2_0", "GL_VERSION_2_1" };
+	for(int i = 0; i < 7; ++i)
+		setSupported(versions[i], true);
+}
+
+void NullDispatch::generateNames( GLsizei n, GLuint* names )
+{
+	for(int i = 0; i < n; ++i)
+		names[i] = m_NextName++;
+}
+
+std::vector<char>& NullDispatch::bufferStorage( GLenum target )
+{
+	return m_BufferStorage[m_BoundBuffers[target]];
+}
+
+void NullDispatch::ActiveTextureARB( GLenum texture )
+{
+	record(DispatchFunction_ActiveTextureARB, texture);
+}
+
+void NullDispatch::BindTexture( GLenum target, GLuint texture )
+{
+	record(DispatchFunction_BindTexture, target, texture);
+}
+
+void NullDispatch::BindSampler( GLuint unit, GLuint sampler )
+{
+	record(DispatchFunction_BindSampler, unit, sampler);
+}
+
+void NullDispatch::BindVertexArray( GLuint array )
+{
+	record(DispatchFunction_BindVertexArray, 0, array);
+}
+
+void NullDispatch::UseProgram( GLuint program )
+{
+	record(DispatchFunction_UseProgram, 0, program);
+}
+
+void NullDispatch::GenBuffersARB( GLsizei n, GLuint* buffers )
+{
+	generateNames(n, buffers);
+	record(DispatchFunction_GenBuffersARB, 0, FirstName(n, buffers));
+}
+
+void NullDispatch::CreateBuffers( GLsizei n, GLuint* buffers )
+{
+	generateNames(n, buffers);
+	record(DispatchFunction_CreateBuffers, 0, FirstName(n, buffers));
+}
+
+void NullDispatch::DeleteBuffersARB( GLsizei n, const GLuint* buffers )
+{
+	record(DispatchFunction_DeleteBuffersARB, 0, FirstName(n, buffers));
+	for(int i = 0; i < n; ++i)
+		m_BufferStorage.erase(buffers[i]);
+}
+
+void NullDispatch::BindBufferARB( GLenum target, GLuint buffer )
+{
+	record(DispatchFunction_BindBufferARB, target, buffer);
+	m_BoundBuffers[target] = buffer;
+}
+
+void NullDispatch::BufferDataARB( GLenum target, GLsizeiptrARB size, const void* data, GLenum usage )
+{
+	record(DispatchFunction_BufferDataARB, target, m_BoundBuffers[target]);
+	std::vector<char>& storage = bufferStorage(target);
+	storage.resize(size);
+	if(data && size > 0)
+		std::memcpy(&storage[0], data, size);
+}
+
+void NullDispatch::NamedBufferData( GLuint buffer, GLsizeiptr size, const void* data, GLenum usage )
+{
+	record(DispatchFunction_NamedBufferData, 0, buffer);
+	std::vector<char>& storage = m_BufferStorage[buffer];
+	storage.resize(size);
+	if(data && size > 0)
+		std::memcpy(&storage[0], data, size);
+}
+
+void NullDispatch::BufferSubDataARB( GLenum target, GLintptrARB offset, GLsizeiptrARB size, const void* data )
+{
+	record(DispatchFunction_BufferSubDataARB, target, m_BoundBuffers[target]);
+	std::vector<char>& storage = bufferStorage(target);
+	assert(offset+size <= (GLsizeiptrARB)storage.size());
+	if(size > 0)
+		std::memcpy(&storage[offset], data, size);
+}
+
+void NullDispatch::NamedBufferSubData( GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data )
+{
+	record(DispatchFunction_NamedBufferSubData, 0, buffer);
+	std::vector<char>& storage = m_BufferStorage[buffer];
+	assert(offset+size <= (GLsizeiptr)storage.size());
+	if(size > 0)
+		std::memcpy(&storage[offset], data, size);
+}
+
+void NullDispatch::GetBufferSubDataARB( GLenum target, GLintptrARB offset, GLsizeiptrARB size, void* data )
+{
+	record(DispatchFunction_GetBufferSubDataARB, target, m_BoundBuffers[target]);
+	std::vector<char>& storage = bufferStorage(target);
+	assert(offset+size <= (GLsizeiptrARB)storage.size());
+	if(size > 0)
+		std::memcpy(data, &storage[offset], size);
+}
+
+void NullDispatch::GetNamedBufferSubData( GLuint buffer, GLintptr offset, GLsizeiptr size, void* data )
+{
+	record(DispatchFunction_GetNamedBufferSubData, 0, buffer);
+	std::vector<char>& storage = m_BufferStorage[buffer];
+	assert(offset+size <= (GLsizeiptr)storage.size());
+	if(size > 0)
+		std::memcpy(data, &storage[offset], size);
+}
+
+void* NullDispatch::MapBufferARB( GLenum target, GLenum access )
+{
+	record(DispatchFunction_MapBufferARB, target, m_BoundBuffers[target]);
+	std::vector<char>& storage = bufferStorage(target);
+	return storage.empty() ? NULL : &storage[0];
+}
+
+void* NullDispatch::MapNamedBuffer( GLuint buffer, GLenum access )
+{
+	record(DispatchFunction_MapNamedBuffer, 0, buffer);
+	std::vector<char>& storage = m_BufferStorage[buffer];
+	return storage.empty() ? NULL : &storage[0];
+}
+
+GLboolean NullDispatch::UnmapBufferARB( GLenum target )
+{
+	record(DispatchFunction_UnmapBufferARB, target, m_BoundBuffers[target]);
+	return GL_TRUE;
+}
+
+GLboolean NullDispatch::UnmapNamedBuffer( GLuint buffer )
+{
+	record(DispatchFunction_UnmapNamedBuffer, 0, buffer);
+	return GL_TRUE;
+}
+
+void NullDispatch::GenTextures( GLsizei n, GLuint* textures )
+{
+	generateNames(n, textures);
+	record(DispatchFunction_GenTextures, 0, FirstName(n, textures));
+}
+
+void NullDispatch::CreateTextures( GLenum target, GLsizei n, GLuint* textures )
+{
+	generateNames(n, textures);
+	record(DispatchFunction_CreateTextures, target, FirstName(n, textures));
+}
+
+void NullDispatch::GenSamplers( GLsizei count, GLuint* samplers )
+{
+	generateNames(count, samplers);
+	record(DispatchFunction_GenSamplers, 0, FirstName(count, samplers));
+}
+
+void NullDispatch::GenVertexArrays( GLsizei n, GLuint* arrays )
+{
+	generateNames(n, arrays);
+	record(DispatchFunction_GenVertexArrays, 0, FirstName(n, arrays));
+}
+
+void NullDispatch::GenQueries( GLsizei n, GLuint* ids )
+{
+	generateNames(n, ids);
+	record(DispatchFunction_GenQueries, 0, FirstName(n, ids));
+}
+
+GLuint NullDispatch::CreateShader( GLenum type )
+{
+	record(DispatchFunction_CreateShader, type, m_NextName);
+	return m_NextName++;
+}
+
+GLuint NullDispatch::CreateProgram()
+{
+	record(DispatchFunction_CreateProgram, 0, m_NextName);
+	return m_NextName++;
+}
+
+void NullDispatch::DeleteTextures( GLsizei n, const GLuint* textures )
+{
+	record(DispatchFunction_DeleteTextures, 0, FirstName(n, textures));
+}
+
+void NullDispatch::DeleteSamplers( GLsizei count, const GLuint* samplers )
+{
+	record(DispatchFunction_DeleteSamplers, 0, FirstName(count, samplers));
+}
+
+void NullDispatch::DeleteVertexArrays( GLsizei n, const GLuint* arrays )
+{
+	record(DispatchFunction_DeleteVertexArrays, 0, FirstName(n, arrays));
+}
+
+void NullDispatch::DeleteQueries( GLsizei n, const GLuint* ids )
+{
+	record(DispatchFunction_DeleteQueries, 0, FirstName(n, ids));
+}
+
+void NullDispatch::DeleteShader( GLuint shader )
+{
+	record(DispatchFunction_DeleteShader, 0, shader);
+}
+
+void NullDispatch::DeleteProgram( GLuint program )
+{
+	record(DispatchFunction_DeleteProgram, 0, program);
+}
+
+const GLubyte* NullDispatch::GetString( GLenum name )
+{
+	record(DispatchFunction_GetString);
+	switch(name)
+	{
+		case GL_VERSION:                  return (const GLubyte*)"2.1 Null";
+		case GL_VENDOR:                   return (const GLubyte*)"SparkPlug";
+		case GL_RENDERER:                 return (const GLubyte*)"Null";
+		case GL_SHADING_LANGUAGE_VERSION: return (const GLubyte*)"1.20";
+		default:                          return (const GLubyte*)"";
+	}
+}
+
+void NullDispatch::GetIntegerv( GLenum pname, GLint* params )
+{
+	record(DispatchFunction_GetIntegerv);
+	switch(pname)
+	{
+		case GL_MAX_COLOR_ATTACHMENTS:             *params = 8; break;
+		case GL_MAX_DRAW_BUFFERS:                  *params = 8; break;
+		case GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS:    *params = 16; break;
+		case GL_MAX_TEXTURE_IMAGE_UNITS:           *params = 16; break;
+		case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:  *params = 32; break;
+		case GL_MAX_TEXTURE_SIZE:                  *params = 8192; break;
+		case GL_MAX_3D_TEXTURE_SIZE:               *params = 2048; break;
+		case GL_MAX_RECTANGLE_TEXTURE_SIZE:        *params = 8192; break;
+		case GL_MAX_CUBE_MAP_TEXTURE_SIZE:         *params = 8192; break;
+		case GL_MAX_TEXTURE_COORDS:                *params = 8; break;
+		case GL_MAX_VERTEX_ATTRIBS:                *params = 16; break;
+		default:                                   *params = 0;
+	}
+}
+
+void NullDispatch::GetFloatv( GLenum pname, GLfloat* params )
+{
+	record(DispatchFunction_GetFloatv);
+	*params = 0.0f;
+}
+
+void NullDispatch::GetShaderiv( GLuint shader, GLenum pname, GLint* params )
+{
+	record(DispatchFunction_GetShaderiv, 0, shader);
+	*params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+}
+
+void NullDispatch::GetProgramiv( GLuint program, GLenum pname, GLint* params )
+{
+	record(DispatchFunction_GetProgramiv, 0, program);
+	switch(pname)
+	{
+		case GL_LINK_STATUS:
+		case GL_VALIDATE_STATUS:
+			*params = GL_TRUE;
+			break;
+
+		default:
+			*params = 0;
+	}
+}
+
+GLint NullDispatch::GetUniformLocation( GLuint program, const GLchar* name )
+{
+	record(DispatchFunction_GetUniformLocation, 0, program);
+	return -1;
+}
+
+void NullDispatch::GetTexLevelParameteriv( GLenum target, GLint level, GLenum pname, GLint* params )
+{
+	record(DispatchFunction_GetTexLevelParameteriv, target);
+	*params = 1; // Proxy textures always fit
+}
+
+void NullDispatch::GetQueryObjectiv( GLuint id, GLenum pname, GLint* params )
+{
+	record(DispatchFunction_GetQueryObjectiv, 0, id);
+	*params = (pname == GL_QUERY_RESULT_AVAILABLE) ? GL_TRUE : 0;
+}
+
+}
+}
@@ -0,0 +1,151 @@
+#ifndef __SPARKPLUG_GL_NULL_DISPATCH__
+#define __SPARKPLUG_GL_NULL_DISPATCH__
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <SparkPlug/GL/Dispatch.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/**
+ * A recorded call.
+ * Arguments are only known for the functions NullDispatch implements,
+ * everything else leaves them 0.
+ */
+struct DispatchCall
+{
+	DispatchFunction function;
+	GLenum target; // Or the texture unit of BindSampler
+	GLuint name;   // Object the call works on, the first one if it takes several
+};
+
+/**
+ * Does nothing but record the calls.
+ * Functions return zero or NULL.
+ */
+class NoOpDispatch : public Dispatch
+{
+public:
+	NoOpDispatch();
+
+	/**
+	 * Calls in the order they were made.
+	 * Only filled while recording is enabled.
+	 */
+	const std::vector<DispatchCall>& calls() const;
+
+	/**
+	 * Is counted even while recording is disabled.
+	 */
+	int callCount( DispatchFunction function ) const;
+
+	void clearCalls();
+
+	/**
+	 * Enabled by default.
+	 * Disable it to measure the overhead of the library alone.
+	 */
+	void setRecording( bool enabled );
+
+	/**
+	 * Nothing is supported until it's enabled here.
+	 * Takes names like "GL_ARB_sync" or "GL_VERSION_3_2",
+	 * must be set before the context starts.
+	 */
+	void setSupported( const char* name, bool supported );
+	virtual bool isSupported( const char* name );
+
+#define SPARKPLUG_GL_DECLARE(R, Name, Params, Args) virtual R Name Params;
+	SPARKPLUG_GL_FUNCTIONS(SPARKPLUG_GL_DECLARE)
+#undef SPARKPLUG_GL_DECLARE
+
+protected:
+	void record( DispatchFunction function, GLenum target = 0, GLuint name = 0 );
+
+private:
+	std::vector<DispatchCall> m_Calls;
+	int m_Counts[DispatchFunction_Count];
+	bool m_Recording;
+	std::set<std::string> m_Supported;
+};
+
+/**
+ * Backend for machines without a GPU.
+ * Hands out object names, reports plausible limits
+ * and lets every shader compile and link.
+ * Buffer contents are kept, so mapping and reading back work.
+ * Programs have no active uniforms or attributes.
+ * Binds, deletes and buffer calls record their target and object name.
+ *
+ * It reports OpenGL 2.1 without extensions, so the library takes
+ * its fallback paths unless more is enabled with setSupported().
+ */
+class NullDispatch : public NoOpDispatch
+{
+public:
+	NullDispatch();
+
+	virtual void ActiveTextureARB( GLenum texture );
+	virtual void BindTexture( GLenum target, GLuint texture );
+	virtual void BindSampler( GLuint unit, GLuint sampler );
+	virtual void BindVertexArray( GLuint array );
+	virtual void UseProgram( GLuint program );
+
+	virtual void GenBuffersARB( GLsizei n, GLuint* buffers );
+	virtual void CreateBuffers( GLsizei n, GLuint* buffers );
+	virtual void DeleteBuffersARB( GLsizei n, const GLuint* buffers );
+	virtual void BindBufferARB( GLenum target, GLuint buffer );
+	virtual void BufferDataARB( GLenum target, GLsizeiptrARB size, const void* data, GLenum usage );
+	virtual void NamedBufferData( GLuint buffer, GLsizeiptr size, const void* data, GLenum usage );
+	virtual void BufferSubDataARB( GLenum target, GLintptrARB offset, GLsizeiptrARB size, const void* data );
+	virtual void NamedBufferSubData( GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data );
+	virtual void GetBufferSubDataARB( GLenum target, GLintptrARB offset, GLsizeiptrARB size, void* data );
+	virtual void GetNamedBufferSubData( GLuint buffer, GLintptr offset, GLsizeiptr size, void* data );
+	virtual void* MapBufferARB( GLenum target, GLenum access );
+	virtual void* MapNamedBuffer( GLuint buffer, GLenum access );
+	virtual GLboolean UnmapBufferARB( GLenum target );
+	virtual GLboolean UnmapNamedBuffer( GLuint buffer );
+
+	virtual void GenTextures( GLsizei n, GLuint* textures );
+	virtual void CreateTextures( GLenum target, GLsizei n, GLuint* textures );
+	virtual void GenSamplers( GLsizei count, GLuint* samplers );
+	virtual void GenVertexArrays( GLsizei n, GLuint* arrays );
+	virtual void GenQueries( GLsizei n, GLuint* ids );
+	virtual GLuint CreateShader( GLenum type );
+	virtual GLuint CreateProgram();
+
+	virtual void DeleteTextures( GLsizei n, const GLuint* textures );
+	virtual void DeleteSamplers( GLsizei count, const GLuint* samplers );
+	virtual void DeleteVertexArrays( GLsizei n, const GLuint* arrays );
+	virtual void DeleteQueries( GLsizei n, const GLuint* ids );
+	virtual void DeleteShader( GLuint shader );
+	virtual void DeleteProgram( GLuint program );
+
+	virtual const GLubyte* GetString( GLenum name );
+	virtual void GetIntegerv( GLenum pname, GLint* params );
+	virtual void GetFloatv( GLenum pname, GLfloat* params );
+	virtual void GetShaderiv( GLuint shader, GLenum pname, GLint* params );
+	virtual void GetProgramiv( GLuint program, GLenum pname, GLint* params );
+	virtual GLint GetUniformLocation( GLuint program, const GLchar* name );
+	virtual void GetTexLevelParameteriv( GLenum target, GLint level, GLenum pname, GLint* params );
+	virtual void GetQueryObjectiv( GLuint id, GLenum pname, GLint* params );
+
+private:
+	void generateNames( GLsizei n, GLuint* names );
+	std::vector<char>& bufferStorage( GLenum target );
+
+	GLuint m_NextName;
+	std::map<GLenum, GLuint> m_BoundBuffers;
+	std::map<GLuint, std::vector<char> > m_BufferStorage;
+};
+
+}
+}
+
+#endif
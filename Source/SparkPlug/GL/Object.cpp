@@ -1,17 +1,27 @@
+#include <SparkPlug/Common.h>
 #include <SparkPlug/GL/Object.h>
+#include <SparkPlug/GL/Context.h>
 
 namespace SparkPlug
 {
 namespace GL
 {
 
-Object::Object( Context* context ) :
-	m_Context(context)
+Object::Object( Context* context, ObjectType type ) :
+	m_Context(context),
+	m_ObjectType(type)
 {
+	context->m_DeletionQueue.flushIfFull();
+	m_PoolHandle = context->m_ObjectPools[type].add(this);
 }
 
 Object::~Object()
 {
+	// The name is deleted on the thread of the context,
+	// once the GPU is done with it.
+	m_Context->m_DeletionQueue.push(m_ObjectType, m_Handle);
+	if(m_PoolHandle)
+		m_Context->m_ObjectPools[m_ObjectType].remove(m_PoolHandle);
 }
 
 GLuint Object::handle() const
@@ -24,5 +34,37 @@ Context* Object::context() const
 	return m_Context;
 }
 
+ObjectType Object::objectType() const
+{
+	return m_ObjectType;
+}
+
+unsigned int Object::poolHandle() const
+{
+	return m_PoolHandle;
+}
+
+void Object::moveTo( Context* context )
+{
+	leaveContext();
+	enterContext(context);
+}
+
+void Object::leaveContext()
+{
+	assert(m_PoolHandle);
+	m_Context->m_ObjectPools[m_ObjectType].remove(m_PoolHandle);
+	m_PoolHandle = 0;
+}
+
+void Object::enterContext( Context* context )
+{
+	assert(!m_PoolHandle);
+	if(!context->sharesObjectsWith(m_Context))
+		FatalError("Objects can only be moved between contexts which share them.");
+	m_Context = context;
+	m_PoolHandle = m_Context->m_ObjectPools[m_ObjectType].add(this);
+}
+
 }
 }
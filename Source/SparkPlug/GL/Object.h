@@ -3,6 +3,7 @@
 
 #include <SparkPlug/Reference.h>
 #include <SparkPlug/GL/OpenGL.h>
+#include <SparkPlug/GL/ObjectPool.h>
 
 
 
@@ -16,17 +17,54 @@ class Context;
 class Object : public ReferenceCounted
 {
 public:
-	Object( Context* context );
+	Object( Context* context, ObjectType type );
+
+	/**
+	 * The last reference may be dropped on any thread.
+	 * The name is handed to the deletion queue of the context.
+	 */
 	virtual ~Object();
 	
 	GLuint handle() const;
 	Context* context() const;
+
+	ObjectType objectType() const;
+
+	/**
+	 * Slot in the object pool of the context, see Handle.
+	 * Changes when the object is moved to another context,
+	 * 0 while it is between two contexts.
+	 */
+	unsigned int poolHandle() const;
+
+	/**
+	 * Hands the object over to another context of the same share group.
+	 * The old context must not have it bound anymore,
+	 * see Context::releaseBindings().
+	 * Objects held by this one are moved as well.
+	 * Both contexts must belong to the calling thread,
+	 * otherwise use leaveContext() and enterContext().
+	 */
+	void moveTo( Context* context );
+
+	/**
+	 * First half of moveTo(), call it on the thread of the old context.
+	 * Removes the object from its pool, so handles to it resolve to NULL.
+	 */
+	virtual void leaveContext();
+
+	/**
+	 * Second half of moveTo(), call it on the thread of the new context.
+	 */
+	virtual void enterContext( Context* context );
 	
 protected:
 	GLuint m_Handle;
 	
 private:
 	Context* m_Context;
+	ObjectType m_ObjectType;
+	unsigned int m_PoolHandle;
 };
 
 }
@@ -0,0 +1,102 @@
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/ObjectPool.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+const char* AsString( ObjectType type )
+{
+	switch(type)
+	{
+		case ObjectType_Buffer:
+			return "Buffer";
+		case ObjectType_Program:
+			return "Program";
+		case ObjectType_Sampler:
+			return "Sampler";
+		case ObjectType_Shader:
+			return "Shader";
+		case ObjectType_Texture:
+			return "Texture";
+		case ObjectType_Count:
+			;
+	}
+	return "UnknownObjectType";
+}
+
+
+/// ---- ObjectPool ----
+
+ObjectPool::ObjectPool() :
+	m_Size(0)
+{
+}
+
+unsigned int ObjectPool::add( Object* object )
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	unsigned int index = 0;
+	if(m_FreeSlots.empty())
+	{
+		index = m_Objects.size();
+		if(index > IndexMask)
+			FatalError("More than %u objects of one type.", IndexMask+1);
+		m_Objects.push_back(NULL);
+		m_Generations.push_back(1);
+	}
+	else
+	{
+		index = m_FreeSlots.back();
+		m_FreeSlots.pop_back();
+	}
+
+	m_Objects[index] = object;
+	++m_Size;
+	return (m_Generations[index] << IndexBits) | index;
+}
+
+void ObjectPool::remove( unsigned int handle )
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	assert(get(handle));
+	const unsigned int index = handle & IndexMask;
+
+	m_Objects[index] = NULL;
+	--m_Size;
+
+	// Invalidates the handles which are still around.
+	unsigned short& generation = m_Generations[index];
+	if(++generation > GenerationMask)
+		generation = 1;
+
+	m_FreeSlots.push_back(index);
+}
+
+Object* ObjectPool::get( unsigned int handle ) const
+{
+	const unsigned int index = handle & IndexMask;
+	if(index >= m_Objects.size() || m_Generations[index] != (handle >> IndexBits))
+		return NULL;
+	return m_Objects[index];
+}
+
+int ObjectPool::size() const
+{
+	return m_Size;
+}
+
+int ObjectPool::slotCount() const
+{
+	return m_Objects.size();
+}
+
+Object* ObjectPool::slot( int index ) const
+{
+	assert(InsideArray(index, (int)m_Objects.size()));
+	return m_Objects[index];
+}
+
+}
+}
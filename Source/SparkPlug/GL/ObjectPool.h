@@ -0,0 +1,103 @@
+#ifndef __SPARKPLUG_GL_OBJECT_POOL__
+#define __SPARKPLUG_GL_OBJECT_POOL__
+
+#include <vector>
+#include <mutex>
+#include <SparkPlug/Reference.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+class Object;
+
+enum ObjectType
+{
+	ObjectType_Buffer,
+	ObjectType_Program,
+	ObjectType_Sampler,
+	ObjectType_Shader,
+	ObjectType_Texture,
+	ObjectType_Count
+};
+const char* AsString( ObjectType type );
+
+/**
+ * 32 bit reference to an object of a context.
+ * The lower 20 bits select a slot in the pool of the object type,
+ * the upper 12 bits count how often the slot was reused.
+ *
+ * Handles don't touch reference counts and don't keep
+ * the object alive. A stale one resolves to NULL,
+ * see Context::resolve().
+ */
+template<typename T>
+class Handle
+{
+public:
+	Handle() : m_Value(0) {}
+	explicit Handle( unsigned int value ) : m_Value(value) {}
+
+	/**
+	 * So code which assigns references keeps working.
+	 */
+	Handle( const StrongRef<T>& object ) : m_Value(object ? object->poolHandle() : 0) {}
+
+	unsigned int value() const { return m_Value; }
+	bool isNull() const { return m_Value == 0; }
+
+	bool operator == ( const Handle& other ) const { return m_Value == other.m_Value; }
+	bool operator != ( const Handle& other ) const { return m_Value != other.m_Value; }
+	bool operator < ( const Handle& other ) const { return m_Value < other.m_Value; }
+
+private:
+	unsigned int m_Value;
+};
+
+/**
+ * Table of the live objects of one type, indexed by handle.
+ * Freed slots are NULL until they're reused with a new generation.
+ * Only the object pointers are pooled, the GL state stays in the objects.
+ *
+ * Objects may be destroyed on any thread, so add() and remove() are locked.
+ * Lookups aren't: they happen on the thread which owns the context,
+ * which is also the only one that adds, and remove() never moves the table.
+ */
+class ObjectPool
+{
+public:
+	static const int IndexBits = 20;
+	static const unsigned int IndexMask = (1u << IndexBits) - 1;
+	static const unsigned int GenerationMask = (1u << (32-IndexBits)) - 1;
+
+	ObjectPool();
+
+	unsigned int add( Object* object );
+	void remove( unsigned int handle );
+
+	/**
+	 * NULL if the handle is stale.
+	 */
+	Object* get( unsigned int handle ) const;
+
+	/**
+	 * Live objects. Slots may be NULL, so iterate up to slotCount().
+	 */
+	int size() const;
+	int slotCount() const;
+	Object* slot( int index ) const;
+
+private:
+	std::vector<Object*> m_Objects; // NULL if the slot is free
+	std::vector<unsigned short> m_Generations; // Starts at 1, so 0 is never a valid handle
+	std::vector<unsigned int> m_FreeSlots;
+	int m_Size;
+	std::mutex m_Mutex; // Guards changes
+};
+
+}
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include <SparkPlug/Common.h>
 #include <SparkPlug/GL/OpenGL.h>
+#include <SparkPlug/GL/Dispatch.h>
 #include <SparkPlug/GL/Texture.h>
 
 namespace SparkPlug
@@ -47,22 +48,37 @@ const char* AsString( Error error )
 	}
 }
 
-void CheckGl()
+// Several error flags may be set at once, but without a current context
+// some drivers report an error on every call.
+const int MaxPendingErrors = 16;
+
+bool CheckGl( Dispatch& gl )
 {
-	Error e = (Error)glGetError();
-	if(e != Error_None)
+	bool clean = true;
+	Error e = (Error)gl.GetError();
+	for(int i = 0; e != Error_None && i < MaxPendingErrors; ++i, e = (Error)gl.GetError())
 	{
 		LogError("%s", (const char*)AsString(e));
+		clean = false;
 		//Break();
 	}
+	if(e != Error_None)
+		LogError("Too many OpenGL errors, is a context current?");
+	return clean;
 }
 
-void DebugMark( const char* msg )
+bool CheckGl( Dispatch& gl, const char* file, int line )
 {
-	if(GLEW_GREMEDY_string_marker)
+	bool clean = true;
+	Error e = (Error)gl.GetError();
+	for(int i = 0; e != Error_None && i < MaxPendingErrors; ++i, e = (Error)gl.GetError())
 	{
-		glStringMarkerGREMEDY(0, msg);
+		LogError("%s:%d: %s", file, line, (const char*)AsString(e));
+		clean = false;
 	}
+	if(e != Error_None)
+		LogError("%s:%d: Too many OpenGL errors, is a context current?", file, line);
+	return clean;
 }
 
 
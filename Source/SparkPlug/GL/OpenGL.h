@@ -3,13 +3,52 @@
 
 #include <GL/glew.h>
 
+/**
+ * Error checking level, usually set by the build:
+ *
+ * SPARKPLUG_GL_CHECK_OFF:   Errors are never queried.
+ * SPARKPLUG_GL_CHECK_FRAME: Errors are queried once in Context::endFrame().
+ * SPARKPLUG_GL_CHECK_CALL:  Errors are queried after every checked call
+ *                           and reported with file and line.
+ *
+ * glGetError synchronises with the driver,
+ * so release builds default to no checks at all.
+ *
+ * Asserts in the per call paths vanish with NDEBUG as usual.
+ * FatalError is kept at every level for misuse which would otherwise
+ * dereference NULL or hand invalid names to the driver.
+ * It only costs a well predicted branch.
+ */
+#define SPARKPLUG_GL_CHECK_OFF   0
+#define SPARKPLUG_GL_CHECK_FRAME 1
+#define SPARKPLUG_GL_CHECK_CALL  2
+
+#if !defined(SPARKPLUG_GL_CHECK)
+	#if defined(NDEBUG)
+		#define SPARKPLUG_GL_CHECK SPARKPLUG_GL_CHECK_OFF
+	#else
+		#define SPARKPLUG_GL_CHECK SPARKPLUG_GL_CHECK_CALL
+	#endif
+#endif
+
+#if SPARKPLUG_GL_CHECK >= SPARKPLUG_GL_CHECK_CALL
+	#define SPARKPLUG_GL_CHECK_CALL_SITE(gl) SparkPlug::GL::CheckGl(gl, __FILE__, __LINE__)
+#else
+	#define SPARKPLUG_GL_CHECK_CALL_SITE(gl) ((void)0)
+#endif
+
 namespace SparkPlug
 {
 namespace GL
 {
-	void CheckGl();
-	
-	void DebugMark( const char* msg );
+	class Dispatch;
+
+	/**
+	 * Logs all pending errors, regardless of the check level.
+	 * Returns false if there were any.
+	 */
+	bool CheckGl( Dispatch& gl );
+	bool CheckGl( Dispatch& gl, const char* file, int line );
 }
 }
 
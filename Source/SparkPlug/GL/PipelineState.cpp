@@ -0,0 +1,278 @@
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/Context.h>
+#include <SparkPlug/GL/PipelineState.h>
+#include <SparkPlug/GL/Hash.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/// ---- Utils ----
+
+template<class State, class Desc>
+StrongRef<State> FindState( const std::multimap<unsigned int, StrongRef<State> >& states, const Desc& desc, unsigned int hash )
+{
+	typedef typename std::multimap<unsigned int, StrongRef<State> >::const_iterator Iter;
+	std::pair<Iter, Iter> range = states.equal_range(hash);
+	for(Iter i = range.first; i != range.second; ++i)
+	{
+		if(i->second->desc() == desc)
+			return i->second;
+	}
+	return NULL;
+}
+
+
+/// ---- RasterStateDesc ----
+
+RasterStateDesc::RasterStateDesc() :
+	cullMode(CullMode_None),
+	fillMode(FillMode_Solid),
+	frontCounterClockwise(true),
+	scissorTest(false),
+	polygonOffset(false),
+	polygonOffsetFactor(0.f),
+	polygonOffsetUnits(0.f)
+{
+}
+
+bool RasterStateDesc::operator == ( const RasterStateDesc& other ) const
+{
+	return
+		(cullMode == other.cullMode) &&
+		(fillMode == other.fillMode) &&
+		(frontCounterClockwise == other.frontCounterClockwise) &&
+		(scissorTest == other.scissorTest) &&
+		(polygonOffset == other.polygonOffset) &&
+		(polygonOffsetFactor == other.polygonOffsetFactor) &&
+		(polygonOffsetUnits == other.polygonOffsetUnits);
+}
+
+bool RasterStateDesc::operator != ( const RasterStateDesc& other ) const
+{
+	return !(*this == other);
+}
+
+unsigned int RasterStateDesc::hash() const
+{
+	unsigned int h = HashSeed;
+	h = Hash(h, (unsigned int)cullMode);
+	h = Hash(h, (unsigned int)fillMode);
+	h = Hash(h, (unsigned int)frontCounterClockwise);
+	h = Hash(h, (unsigned int)scissorTest);
+	h = Hash(h, (unsigned int)polygonOffset);
+	h = Hash(h, polygonOffsetFactor);
+	h = Hash(h, polygonOffsetUnits);
+	return h;
+}
+
+
+/// ---- BlendStateDesc ----
+
+BlendStateDesc::BlendStateDesc() :
+	blend(false),
+	sourceColor(BlendFactor_One),
+	destinationColor(BlendFactor_Zero),
+	colorOperation(BlendOperation_Add),
+	sourceAlpha(BlendFactor_One),
+	destinationAlpha(BlendFactor_Zero),
+	alphaOperation(BlendOperation_Add),
+	writeRed(true),
+	writeGreen(true),
+	writeBlue(true),
+	writeAlpha(true)
+{
+}
+
+bool BlendStateDesc::operator == ( const BlendStateDesc& other ) const
+{
+	return
+		(blend == other.blend) &&
+		(sourceColor == other.sourceColor) &&
+		(destinationColor == other.destinationColor) &&
+		(colorOperation == other.colorOperation) &&
+		(sourceAlpha == other.sourceAlpha) &&
+		(destinationAlpha == other.destinationAlpha) &&
+		(alphaOperation == other.alphaOperation) &&
+		(writeRed == other.writeRed) &&
+		(writeGreen == other.writeGreen) &&
+		(writeBlue == other.writeBlue) &&
+		(writeAlpha == other.writeAlpha);
+}
+
+bool BlendStateDesc::operator != ( const BlendStateDesc& other ) const
+{
+	return !(*this == other);
+}
+
+unsigned int BlendStateDesc::hash() const
+{
+	unsigned int h = HashSeed;
+	h = Hash(h, (unsigned int)blend);
+	h = Hash(h, (unsigned int)sourceColor);
+	h = Hash(h, (unsigned int)destinationColor);
+	h = Hash(h, (unsigned int)colorOperation);
+	h = Hash(h, (unsigned int)sourceAlpha);
+	h = Hash(h, (unsigned int)destinationAlpha);
+	h = Hash(h, (unsigned int)alphaOperation);
+	h = Hash(h,
+		(writeRed   ? 1u : 0u) |
+		(writeGreen ? 2u : 0u) |
+		(writeBlue  ? 4u : 0u) |
+		(writeAlpha ? 8u : 0u)
+	);
+	return h;
+}
+
+
+/// ---- DepthStencilStateDesc ----
+
+DepthStencilStateDesc::DepthStencilStateDesc() :
+	depthTest(false),
+	depthWrite(true),
+	depthFunction(CompareFunction_Less),
+	stencilTest(false),
+	stencilFunction(CompareFunction_Always),
+	stencilReference(0),
+	stencilReadMask(~0u),
+	stencilWriteMask(~0u),
+	stencilFail(StencilOperation_Keep),
+	stencilDepthFail(StencilOperation_Keep),
+	stencilPass(StencilOperation_Keep)
+{
+}
+
+bool DepthStencilStateDesc::operator == ( const DepthStencilStateDesc& other ) const
+{
+	return
+		(depthTest == other.depthTest) &&
+		(depthWrite == other.depthWrite) &&
+		(depthFunction == other.depthFunction) &&
+		(stencilTest == other.stencilTest) &&
+		(stencilFunction == other.stencilFunction) &&
+		(stencilReference == other.stencilReference) &&
+		(stencilReadMask == other.stencilReadMask) &&
+		(stencilWriteMask == other.stencilWriteMask) &&
+		(stencilFail == other.stencilFail) &&
+		(stencilDepthFail == other.stencilDepthFail) &&
+		(stencilPass == other.stencilPass);
+}
+
+bool DepthStencilStateDesc::operator != ( const DepthStencilStateDesc& other ) const
+{
+	return !(*this == other);
+}
+
+unsigned int DepthStencilStateDesc::hash() const
+{
+	unsigned int h = HashSeed;
+	h = Hash(h, (unsigned int)depthTest);
+	h = Hash(h, (unsigned int)depthWrite);
+	h = Hash(h, (unsigned int)depthFunction);
+	h = Hash(h, (unsigned int)stencilTest);
+	h = Hash(h, (unsigned int)stencilFunction);
+	h = Hash(h, (unsigned int)stencilReference);
+	h = Hash(h, stencilReadMask);
+	h = Hash(h, stencilWriteMask);
+	h = Hash(h, (unsigned int)stencilFail);
+	h = Hash(h, (unsigned int)stencilDepthFail);
+	h = Hash(h, (unsigned int)stencilPass);
+	return h;
+}
+
+
+/// ---- RasterState ----
+
+StrongRef<RasterState> RasterState::Create( Context* context, const RasterStateDesc& desc )
+{
+	unsigned int hash = desc.hash();
+	StrongRef<RasterState> state = FindState(context->m_RasterStates, desc, hash);
+	if(!state)
+	{
+		state = new RasterState(desc);
+		context->m_RasterStates.insert(std::make_pair(hash, state));
+	}
+	return state;
+}
+
+RasterState::RasterState( const RasterStateDesc& desc ) :
+	m_Desc(desc),
+	m_Hash(desc.hash())
+{
+}
+
+const RasterStateDesc& RasterState::desc() const
+{
+	return m_Desc;
+}
+
+unsigned int RasterState::hash() const
+{
+	return m_Hash;
+}
+
+
+/// ---- BlendState ----
+
+StrongRef<BlendState> BlendState::Create( Context* context, const BlendStateDesc& desc )
+{
+	unsigned int hash = desc.hash();
+	StrongRef<BlendState> state = FindState(context->m_BlendStates, desc, hash);
+	if(!state)
+	{
+		state = new BlendState(desc);
+		context->m_BlendStates.insert(std::make_pair(hash, state));
+	}
+	return state;
+}
+
+BlendState::BlendState( const BlendStateDesc& desc ) :
+	m_Desc(desc),
+	m_Hash(desc.hash())
+{
+}
+
+const BlendStateDesc& BlendState::desc() const
+{
+	return m_Desc;
+}
+
+unsigned int BlendState::hash() const
+{
+	return m_Hash;
+}
+
+
+/// ---- DepthStencilState ----
+
+StrongRef<DepthStencilState> DepthStencilState::Create( Context* context, const DepthStencilStateDesc& desc )
+{
+	unsigned int hash = desc.hash();
+	StrongRef<DepthStencilState> state = FindState(context->m_DepthStencilStates, desc, hash);
+	if(!state)
+	{
+		state = new DepthStencilState(desc);
+		context->m_DepthStencilStates.insert(std::make_pair(hash, state));
+	}
+	return state;
+}
+
+DepthStencilState::DepthStencilState( const DepthStencilStateDesc& desc ) :
+	m_Desc(desc),
+	m_Hash(desc.hash())
+{
+}
+
+const DepthStencilStateDesc& DepthStencilState::desc() const
+{
+	return m_Desc;
+}
+
+unsigned int DepthStencilState::hash() const
+{
+	return m_Hash;
+}
+
+}
+}
@@ -0,0 +1,142 @@
+#ifndef __SPARKPLUG_GL_PIPELINE_STATE__
+#define __SPARKPLUG_GL_PIPELINE_STATE__
+
+#include <SparkPlug/Reference.h>
+#include <SparkPlug/GL/OpenGL.h>
+#include <SparkPlug/GL/Enums.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+class Context;
+
+/**
+ * Pipeline state is described with plain descriptions
+ * which are turned into immutable, hashed state objects.
+ * Equal descriptions map to the same object,
+ * so the context can skip redundant changes by comparing pointers
+ * and applies the rest by diffing against its own shadow copy.
+ *
+ * The default constructed descriptions match the OpenGL defaults.
+ */
+
+class RasterStateDesc
+{
+public:
+	RasterStateDesc();
+
+	bool operator == ( const RasterStateDesc& other ) const;
+	bool operator != ( const RasterStateDesc& other ) const;
+
+	unsigned int hash() const;
+
+	CullMode cullMode;
+	FillMode fillMode;
+	bool     frontCounterClockwise;
+	bool     scissorTest;
+	bool     polygonOffset;
+	float    polygonOffsetFactor;
+	float    polygonOffsetUnits;
+};
+
+class BlendStateDesc
+{
+public:
+	BlendStateDesc();
+
+	bool operator == ( const BlendStateDesc& other ) const;
+	bool operator != ( const BlendStateDesc& other ) const;
+
+	unsigned int hash() const;
+
+	bool           blend;
+	BlendFactor    sourceColor;
+	BlendFactor    destinationColor;
+	BlendOperation colorOperation;
+	BlendFactor    sourceAlpha;
+	BlendFactor    destinationAlpha;
+	BlendOperation alphaOperation;
+
+	bool writeRed;
+	bool writeGreen;
+	bool writeBlue;
+	bool writeAlpha;
+};
+
+class DepthStencilStateDesc
+{
+public:
+	DepthStencilStateDesc();
+
+	bool operator == ( const DepthStencilStateDesc& other ) const;
+	bool operator != ( const DepthStencilStateDesc& other ) const;
+
+	unsigned int hash() const;
+
+	bool            depthTest;
+	bool            depthWrite;
+	CompareFunction depthFunction;
+
+	bool             stencilTest;
+	CompareFunction  stencilFunction;
+	int              stencilReference;
+	unsigned int     stencilReadMask;
+	unsigned int     stencilWriteMask;
+	StencilOperation stencilFail;
+	StencilOperation stencilDepthFail;
+	StencilOperation stencilPass;
+};
+
+
+class RasterState : public ReferenceCounted
+{
+public:
+	static StrongRef<RasterState> Create( Context* context, const RasterStateDesc& desc );
+
+	const RasterStateDesc& desc() const;
+	unsigned int hash() const;
+
+private:
+	RasterState( const RasterStateDesc& desc );
+
+	const RasterStateDesc m_Desc;
+	const unsigned int    m_Hash;
+};
+
+class BlendState : public ReferenceCounted
+{
+public:
+	static StrongRef<BlendState> Create( Context* context, const BlendStateDesc& desc );
+
+	const BlendStateDesc& desc() const;
+	unsigned int hash() const;
+
+private:
+	BlendState( const BlendStateDesc& desc );
+
+	const BlendStateDesc m_Desc;
+	const unsigned int   m_Hash;
+};
+
+class DepthStencilState : public ReferenceCounted
+{
+public:
+	static StrongRef<DepthStencilState> Create( Context* context, const DepthStencilStateDesc& desc );
+
+	const DepthStencilStateDesc& desc() const;
+	unsigned int hash() const;
+
+private:
+	DepthStencilState( const DepthStencilStateDesc& desc );
+
+	const DepthStencilStateDesc m_Desc;
+	const unsigned int          m_Hash;
+};
+
+}
+}
+
+#endif
@@ -134,26 +134,10 @@ GLenum ConvertToGL( const PixelFormat& format, bool sRGB )
 			switch(format.semantic())
 			{
 				case PixelSemantic_Luminance:
-				{
-					if(!GLEW_ARB_texture_float)
-					{
-						FatalError("GLEW_ARB_texture_float not supported");
-						break;
-					}
-					
 					return GL_LUMINANCE16F_ARB;
-				}
 				
 				case PixelSemantic_LuminanceAlpha:
-				{
-					if(!GLEW_ARB_texture_float)
-					{
-						FatalError("GLEW_ARB_texture_float not supported");
-						break;
-					}
-					
 					return GL_LUMINANCE_ALPHA16F_ARB;
-				}
 				
 				case PixelSemantic_RGB:
 					return GL_RGB16F;
@@ -173,26 +157,10 @@ GLenum ConvertToGL( const PixelFormat& format, bool sRGB )
 			switch(format.semantic())
 			{
 				case PixelSemantic_Luminance:
-				{
-					if(!GLEW_ARB_texture_float)
-					{
-						FatalError("GLEW_ARB_texture_float not supported");
-						break;
-					}
-					
 					return GL_LUMINANCE32F_ARB;
-				}
 				
 				case PixelSemantic_LuminanceAlpha:
-				{
-					if(!GLEW_ARB_texture_float)
-					{
-						FatalError("GLEW_ARB_texture_float not supported");
-						break;
-					}
-					
 					return GL_LUMINANCE_ALPHA32F_ARB;
-				}
 				
 				case PixelSemantic_RGB:
 					return GL_RGB32F;
@@ -10,6 +10,11 @@ namespace GL
 {
 	GLenum ConvertToGL( PixelComponent component );
 	GLenum ConvertToGL( PixelSemantic semantic );
+
+	/**
+	 * Doesn't check whether the driver supports the format,
+	 * Texture::TestTextureCreation() does.
+	 */
 	GLenum ConvertToGL( const PixelFormat& format, bool sRGB );
 
 }
@@ -0,0 +1,142 @@
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/Context.h>
+#include <SparkPlug/GL/ResourceWorker.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/// ---- ResourceWorker ----
+
+ResourceWorker::ResourceWorker( Context* mainContext, Context* workerContext ) :
+	m_MainContext(mainContext),
+	m_WorkerContext(workerContext),
+	m_Pending(0),
+	m_Running(true)
+{
+	if(!workerContext->sharesObjectsWith(mainContext))
+		FatalError("The worker context must share objects with the main context.");
+
+	m_Thread = std::thread(&ResourceWorker::run, this);
+}
+
+ResourceWorker::~ResourceWorker()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Running = false;
+	}
+	m_Wake.notify_one();
+	m_Thread.join();
+
+	for(; !m_Queued.empty(); m_Queued.pop_front())
+		discard(m_Queued.front());
+	for(; !m_Finished.empty(); m_Finished.pop_front())
+		discard(m_Finished.front());
+}
+
+void ResourceWorker::discard( Task* task )
+{
+	// The worker thread is gone, so release everything through the main context.
+	// Finished results left the worker context already, queued ones have none.
+	if(task->result)
+		task->result->enterContext(m_MainContext);
+	task->fence.moveTo(m_MainContext);
+	delete task;
+}
+
+void ResourceWorker::submit( const Job& job, const Completion& completion )
+{
+	Task* task = new Task(m_WorkerContext);
+	task->job = job;
+	task->completion = completion;
+	++m_Pending;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Queued.push_back(task);
+	}
+	m_Wake.notify_one();
+}
+
+int ResourceWorker::poll()
+{
+	int completed = 0;
+	for(;;)
+	{
+		Task* task = NULL;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if(m_Finished.empty())
+				break;
+			task = m_Finished.front();
+		}
+
+		// Fences of one context are signaled in order,
+		// so the later ones can't be done either.
+		task->fence.moveTo(m_MainContext);
+		if(!task->fence.isSignaled())
+			break;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Finished.pop_front();
+		}
+
+		if(task->result)
+			task->result->enterContext(m_MainContext);
+		if(task->completion)
+			task->completion(task->result);
+		delete task;
+
+		--m_Pending;
+		++completed;
+	}
+	return completed;
+}
+
+int ResourceWorker::pendingJobs() const
+{
+	return m_Pending;
+}
+
+void ResourceWorker::run()
+{
+	m_WorkerContext->makeCurrent();
+
+	for(;;)
+	{
+		Task* task = NULL;
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			while(m_Running && m_Queued.empty())
+				m_Wake.wait(lock);
+			if(!m_Running)
+				break;
+			task = m_Queued.front();
+			m_Queued.pop_front();
+		}
+
+		task->result = task->job(m_WorkerContext);
+		task->job = Job(); // Drops what the job captured on this thread
+
+		// The main context may delete the objects as soon as it has them.
+		m_WorkerContext->releaseBindings();
+		m_WorkerContext->endFrame(); // Deletes what the job dropped
+
+		// The pools of a context are only touched by its own thread,
+		// so the result leaves the worker pool here and enters the main one in poll().
+		if(task->result)
+			task->result->leaveContext();
+		task->fence.insert();
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Finished.push_back(task);
+	}
+
+	m_WorkerContext->releaseCurrent();
+}
+
+}
+}
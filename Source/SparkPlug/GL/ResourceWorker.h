@@ -0,0 +1,106 @@
+#ifndef __SPARKPLUG_GL_RESOURCE_WORKER__
+#define __SPARKPLUG_GL_RESOURCE_WORKER__
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <SparkPlug/Reference.h>
+#include <SparkPlug/GL/Object.h>
+#include <SparkPlug/GL/Fence.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+class Context;
+
+/**
+ * Creates objects and uploads their data on a separate thread,
+ * using a context which shares objects with the main context.
+ * Finished objects are handed to the main context once
+ * the GPU has executed their commands, which is checked with fences.
+ *
+ * Jobs run one at a time, in the order they were submitted.
+ * Completions are called by poll() on the main thread in the same order.
+ */
+class ResourceWorker
+{
+public:
+	/**
+	 * Runs on the worker thread.
+	 * The returned object, may be NULL, is passed to the completion.
+	 * Jobs must not touch references owned by other threads,
+	 * because reference counts aren't atomic.
+	 */
+	typedef std::function<StrongRef<Object>( Context* context )> Job;
+
+	/**
+	 * Runs on the main thread.
+	 * The object belongs to the main context by then.
+	 */
+	typedef std::function<void( const StrongRef<Object>& object )> Completion;
+
+	/**
+	 * The worker context must share objects with the main context,
+	 * implement Context::makeCurrent() and not be current on any thread.
+	 * Neither is owned by the worker, both must outlive it.
+	 */
+	ResourceWorker( Context* mainContext, Context* workerContext );
+
+	/**
+	 * Waits for the running job.
+	 * Queued jobs are dropped and completions aren't called anymore.
+	 */
+	~ResourceWorker();
+
+	void submit( const Job& job, const Completion& completion );
+
+	/**
+	 * Call it regularly on the main thread, like once per frame.
+	 * Never blocks.
+	 * Returns how many completions were called.
+	 */
+	int poll();
+
+	/**
+	 * Jobs which were submitted but not completed yet.
+	 */
+	int pendingJobs() const;
+
+private:
+	ResourceWorker( const ResourceWorker& source );
+	ResourceWorker& operator = ( const ResourceWorker& source );
+
+	struct Task
+	{
+		Task( Context* context ) : fence(context) {}
+
+		Job job;
+		Completion completion;
+		StrongRef<Object> result;
+		Fence fence;
+	};
+
+	void run();
+	void discard( Task* task );
+
+	Context* m_MainContext;
+	Context* m_WorkerContext;
+	int m_Pending; // Only touched by the main thread
+
+	std::mutex m_Mutex;
+	std::condition_variable m_Wake;
+	std::deque<Task*> m_Queued; // Waiting for the worker
+	std::deque<Task*> m_Finished; // Waiting for their fence
+	bool m_Running;
+	std::thread m_Thread;
+};
+
+}
+}
+
+#endif
@@ -1,3 +1,4 @@
+#include <SparkPlug/GL/Context.h>
 #include <SparkPlug/GL/Sampler.h>
 
 namespace SparkPlug
@@ -6,22 +7,21 @@ namespace GL
 {
 
 Sampler::Sampler( Context* context ) :
-	SamplerBase(context)
+	SamplerBase(context, ObjectType_Sampler)
 {
-	glGenSamplers(1, &m_Handle);
+	m_Handle = context->m_NamePool.acquire(NameKind_Sampler);
 }
 
 Sampler::~Sampler()
 {
-	glDeleteSamplers(1, &m_Handle);
 }
 
 void Sampler::setFilter( TextureFilter f )
 {
 	if(f == filter())
 		return;
-	glSamplerParameteri(m_Handle, GL_TEXTURE_MIN_FILTER, ConvertToGL(f, true));
-	glSamplerParameteri(m_Handle, GL_TEXTURE_MAG_FILTER, ConvertToGL(f, false));
+	context()->gl().SamplerParameteri(m_Handle, GL_TEXTURE_MIN_FILTER, ConvertToGL(f, true));
+	context()->gl().SamplerParameteri(m_Handle, GL_TEXTURE_MAG_FILTER, ConvertToGL(f, false));
 	SamplerBase::setFilter(f);
 }
 
@@ -29,9 +29,9 @@ void Sampler::setAddressMode( TextureAddressMode m )
 {
 	if(m == addressMode())
 		return;
-	glSamplerParameteri(m_Handle, GL_TEXTURE_WRAP_S, ConvertToGL(m));
-	glSamplerParameteri(m_Handle, GL_TEXTURE_WRAP_T, ConvertToGL(m));
-	glSamplerParameteri(m_Handle, GL_TEXTURE_WRAP_R, ConvertToGL(m));
+	context()->gl().SamplerParameteri(m_Handle, GL_TEXTURE_WRAP_S, ConvertToGL(m));
+	context()->gl().SamplerParameteri(m_Handle, GL_TEXTURE_WRAP_T, ConvertToGL(m));
+	context()->gl().SamplerParameteri(m_Handle, GL_TEXTURE_WRAP_R, ConvertToGL(m));
 	SamplerBase::setAddressMode(m);
 }
 
@@ -39,7 +39,7 @@ void Sampler::setMaxAnisotropic( float level )
 {
 	if(level == maxAnisotropic())
 		return;
-	glSamplerParameterf(m_Handle, GL_TEXTURE_MAX_ANISOTROPY_EXT, level);
+	context()->gl().SamplerParameterf(m_Handle, GL_TEXTURE_MAX_ANISOTROPY_EXT, level);
 	SamplerBase::setMaxAnisotropic(level);
 }
 
@@ -14,6 +14,8 @@ class Context;
 class Sampler : public SamplerBase
 {
 public:
+	static const ObjectType PoolType = ObjectType_Sampler;
+
 	Sampler( Context* context );
 	~Sampler();
 	
@@ -31,16 +31,16 @@ std::string StringFromFile( const char* path )
 	return r;
 }
 
-void ShowShaderLog( GLuint handle )
+void ShowShaderLog( Context* context, GLuint handle )
 {
 	GLint length = 0;
-	glGetShaderiv(handle, GL_INFO_LOG_LENGTH, &length);
+	context->gl().GetShaderiv(handle, GL_INFO_LOG_LENGTH, &length);
 
 	char* log = NULL;
 	if(length)
 	{
 		log = new char[length];
-		glGetShaderInfoLog(handle, length, NULL, log);
+		context->gl().GetShaderInfoLog(handle, length, NULL, log);
 	}
 
 	if(log)
@@ -50,16 +50,16 @@ void ShowShaderLog( GLuint handle )
 	}
 }
 
-void ShowProgramLog( GLuint handle )
+void ShowProgramLog( Context* context, GLuint handle )
 {
 	GLint length = 0;
-	glGetProgramiv(handle, GL_INFO_LOG_LENGTH, &length);
+	context->gl().GetProgramiv(handle, GL_INFO_LOG_LENGTH, &length);
 
 	char* log = NULL;
 	if(length)
 	{
 		log = new char[length];
-		glGetProgramInfoLog(handle, length, NULL, log);
+		context->gl().GetProgramInfoLog(handle, length, NULL, log);
 	}
 
 	if(log)
@@ -72,14 +72,13 @@ void ShowProgramLog( GLuint handle )
 
 /// Shader Object ///
 Shader::Shader( Context* context, ShaderType type ) :
-	Object(context)
+	Object(context, ObjectType_Shader)
 {
-	m_Handle = glCreateShader(ConvertToGL(type));
+	m_Handle = context->gl().CreateShader(ConvertToGL(type));
 }
 
 Shader::~Shader()
 {
-	glDeleteShader(m_Handle);
 }
 
 std::string Shader::toString() const
@@ -102,14 +101,14 @@ StrongRef<Shader> Shader::CreateFromFile( Context* context, ShaderType type, con
 
 	const char* shaderSource = source.c_str();
 	int shaderLength = source.length();
-	glShaderSource(obj->m_Handle, 1, &shaderSource, &shaderLength);
-
-	glCompileShader(obj->m_Handle);
+	context->gl().ShaderSource(obj->m_Handle, 1, &shaderSource, &shaderLength);
 
+	context->gl().CompileShader(obj->m_Handle);
+	SPARKPLUG_GL_CHECK_CALL_SITE(context->gl());
 
 	GLint state;
-	glGetShaderiv(obj->m_Handle, GL_COMPILE_STATUS, &state);
-	ShowShaderLog(obj->m_Handle);
+	context->gl().GetShaderiv(obj->m_Handle, GL_COMPILE_STATUS, &state);
+	ShowShaderLog(context, obj->m_Handle);
 	if(state)
     {
 		Log("Compiled shader object '%s' successfully", file);
@@ -126,15 +125,14 @@ StrongRef<Shader> Shader::CreateFromFile( Context* context, ShaderType type, con
 
 /// Program ///
 Program::Program( Context* context ) :
-	Object(context),
+	Object(context, ObjectType_Program),
 	m_Dirty(true)
 {
-	m_Handle = glCreateProgram();
+	m_Handle = context->gl().CreateProgram();
 }
 
 Program::~Program()
 {
-	glDeleteProgram(m_Handle);
 }
 
 std::string Program::toString() const
@@ -147,6 +145,26 @@ std::string Program::toString() const
 	return buf;
 }
 
+void Program::leaveContext()
+{
+	Object::leaveContext();
+
+	std::set< StrongRef<Shader> >::const_iterator i = m_AttachedObjects.begin();
+	for(; i != m_AttachedObjects.end(); ++i)
+		if((*i)->poolHandle()) // Shaders may be attached to several programs
+			(*i)->leaveContext();
+}
+
+void Program::enterContext( Context* context )
+{
+	Object::enterContext(context);
+
+	std::set< StrongRef<Shader> >::const_iterator i = m_AttachedObjects.begin();
+	for(; i != m_AttachedObjects.end(); ++i)
+		if(!(*i)->poolHandle())
+			(*i)->enterContext(context);
+}
+
 StrongRef<Program> Program::Create( Context* context )
 {
 	return StrongRef<Shader>(new Program(context));
@@ -158,7 +176,7 @@ bool Program::attach( StrongRef<Shader> object )
 		return true;
 
 	m_AttachedObjects.insert(object);
-	glAttachShader(m_Handle, object->handle());
+	context()->gl().AttachShader(m_Handle, object->handle());
 	m_Dirty = true;
 	return true;
 }
@@ -169,7 +187,7 @@ bool Program::detach( StrongRef<Shader> object )
 		return true;
 
 	m_AttachedObjects.erase(object);
-	glDetachShader(m_Handle, object->handle());
+	context()->gl().DetachShader(m_Handle, object->handle());
 	m_Dirty = true;
 	return true;
 }
@@ -177,7 +195,7 @@ bool Program::detach( StrongRef<Shader> object )
 bool Program::link()
 {
 	bool r = linkSilent();
-	ShowProgramLog(m_Handle);
+	ShowProgramLog(context(), m_Handle);
 	if(r)
 		Log("Linked shader program %s successfully ", toString().c_str());
 	else
@@ -190,9 +208,10 @@ bool Program::linkSilent()
 	if(!m_Dirty)
 		return true;
 
-	glLinkProgram(m_Handle);
+	context()->gl().LinkProgram(m_Handle);
+	SPARKPLUG_GL_CHECK_CALL_SITE(context()->gl());
 	GLint state;
-	glGetProgramiv(m_Handle, GL_LINK_STATUS, &state);
+	context()->gl().GetProgramiv(m_Handle, GL_LINK_STATUS, &state);
 	readUniformLocations();
 	readAttributeSizes();
 
@@ -203,7 +222,7 @@ bool Program::linkSilent()
 bool Program::validate()
 {
 	bool r = validateSilent();
-	ShowProgramLog(m_Handle);
+	ShowProgramLog(context(), m_Handle);
 	if(r)
 		Log("Validated shader program successfully %s", toString().c_str());
 	else
@@ -213,9 +232,9 @@ bool Program::validate()
 
 bool Program::validateSilent()
 {
-	glValidateProgram(m_Handle);
+	context()->gl().ValidateProgram(m_Handle);
 	GLint state;
-	glGetProgramiv(m_Handle, GL_VALIDATE_STATUS, &state);
+	context()->gl().GetProgramiv(m_Handle, GL_VALIDATE_STATUS, &state);
 	return state != 0;
 }
 
@@ -224,7 +243,7 @@ void Program::readUniformLocations()
 	m_UniformLocations.clear();
 
 	int uniformCount = -1;
-	glGetProgramiv(m_Handle, GL_ACTIVE_UNIFORMS, &uniformCount);
+	context()->gl().GetProgramiv(m_Handle, GL_ACTIVE_UNIFORMS, &uniformCount);
 
 	for(int i = 0; i < uniformCount; ++i)
 	{
@@ -234,10 +253,10 @@ void Program::readUniformLocations()
 		int size = -1;
 		GLenum type = GL_ZERO;
 
-		glGetActiveUniform(m_Handle, i, sizeof(name)-1, &nameLength, &size, &type, name);
+		context()->gl().GetActiveUniform(m_Handle, i, sizeof(name)-1, &nameLength, &size, &type, name);
 		assert(nameLength > 0);
 
-		GLuint location = glGetUniformLocation(m_Handle, name);
+		GLuint location = context()->gl().GetUniformLocation(m_Handle, name);
 
 		m_UniformLocations[name] = location;
 	}
@@ -248,7 +267,7 @@ void Program::readAttributeSizes()
 	m_AttributeSizes.clear();
 
 	int attributeCount = -1;
-	glGetProgramiv(m_Handle, GL_OBJECT_ACTIVE_ATTRIBUTES_ARB, &attributeCount);
+	context()->gl().GetProgramiv(m_Handle, GL_OBJECT_ACTIVE_ATTRIBUTES_ARB, &attributeCount);
 
 	for(int i = 0; i < attributeCount; ++i)
 	{
@@ -258,7 +277,7 @@ void Program::readAttributeSizes()
 		GLenum type = GL_ZERO;
 		int normalized = -1;
 
-		glGetActiveAttrib(
+		context()->gl().GetActiveAttrib(
 			m_Handle,
 			i,
 			sizeof(name)-1,
@@ -336,7 +355,7 @@ void Program::setAttributes( const VertexFormat& reference )
 			return;
 		}
 
-		glBindAttribLocation(m_Handle, i, attribute.name());
+		context()->gl().BindAttribLocation(m_Handle, reference.attributeLocation(i), attribute.name());
 		m_Dirty = true;
 	}
 
@@ -358,8 +377,17 @@ bool Program::setUniform( const char* name, int value )
 	if(location == -1)
 		return false;
 
-	ProgramBinding binding(context(), this);
-	glUniform1i(location, value);
+	++context()->m_Stats.uniformUploads;
+
+	if(context()->m_DirectStateAccess)
+	{
+		context()->gl().ProgramUniform1i(m_Handle, location, value);
+	}
+	else
+	{
+		context()->bindProgramForEdit(this);
+		context()->gl().Uniform1i(location, value);
+	}
 	return true;
 }
 
@@ -369,8 +397,17 @@ bool Program::setUniform( const char* name, float value )
 	if(location == -1)
 		return false;
 
-	ProgramBinding binding(context(), this);
-	glUniform1f(location, value);
+	++context()->m_Stats.uniformUploads;
+
+	if(context()->m_DirectStateAccess)
+	{
+		context()->gl().ProgramUniform1f(m_Handle, location, value);
+	}
+	else
+	{
+		context()->bindProgramForEdit(this);
+		context()->gl().Uniform1f(location, value);
+	}
 	return true;
 }
 
@@ -380,13 +417,28 @@ bool Program::setUniform( const char* name, int length, const float* values )
 	if(location == -1)
 		return false;
 
-	ProgramBinding binding(context(), this);
+	++context()->m_Stats.uniformUploads;
+
+	if(context()->m_DirectStateAccess)
+	{
+		switch(length)
+		{
+			case 1: context()->gl().ProgramUniform1fv(m_Handle, location, 1, values); break;
+			case 2: context()->gl().ProgramUniform2fv(m_Handle, location, 1, values); break;
+			case 3: context()->gl().ProgramUniform3fv(m_Handle, location, 1, values); break;
+			case 4: context()->gl().ProgramUniform4fv(m_Handle, location, 1, values); break;
+			default: assert(false);
+		}
+		return true;
+	}
+
+	context()->bindProgramForEdit(this);
 	switch(length)
 	{
-		case 1: glUniform1fv(location, 1, values); break;
-		case 2: glUniform2fv(location, 1, values); break;
-		case 3: glUniform3fv(location, 1, values); break;
-		case 4: glUniform4fv(location, 1, values); break;
+		case 1: context()->gl().Uniform1fv(location, 1, values); break;
+		case 2: context()->gl().Uniform2fv(location, 1, values); break;
+		case 3: context()->gl().Uniform3fv(location, 1, values); break;
+		case 4: context()->gl().Uniform4fv(location, 1, values); break;
 		default: assert(false);
 	}
 	return true;
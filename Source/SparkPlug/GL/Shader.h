@@ -19,6 +19,8 @@ namespace GL
 class Shader : public Object
 {
 public:
+	static const ObjectType PoolType = ObjectType_Shader;
+
 	static StrongRef<Shader> CreateFromFile( Context* context, ShaderType type, const char* file );
 	~Shader();
 
@@ -33,11 +35,16 @@ private:
 class Program : public Object
 {
 public:
+	static const ObjectType PoolType = ObjectType_Program;
+
 	static StrongRef<Program> Create( Context* context );
 	~Program();
 
 	std::string toString() const;
 
+	virtual void leaveContext();
+	virtual void enterContext( Context* context );
+
 	bool attach( StrongRef<Shader> object );
 	bool detach( StrongRef<Shader> object );
 
@@ -0,0 +1,154 @@
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/Context.h>
+#include <SparkPlug/GL/StreamBuffer.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/// ---- StreamBuffer ----
+
+StrongRef<StreamBuffer> StreamBuffer::Create( Context* context, BufferTarget target, int elementSize, int regionSize, int regionCount )
+{
+	return new StreamBuffer(context, target, elementSize, regionSize, regionCount);
+}
+
+StreamBuffer::StreamBuffer( Context* context, BufferTarget target, int elementSize, int regionSize, int regionCount ) :
+	Buffer(context, target, BufferUsage_Stream, regionSize*regionCount, elementSize),
+	m_Persistent(context->m_UseBufferStorage),
+	m_RegionSize(regionSize),
+	m_RegionCount(regionCount),
+	m_Region(0),
+	m_Offset(0),
+	m_CommitOffset(0),
+	m_Mapping(NULL)
+{
+	assert(regionSize > 0);
+	assert(regionCount > 0);
+
+	if(m_Persistent)
+	{
+		for(int i = 0; i < m_RegionCount; ++i)
+			m_Fences.push_back(std::unique_ptr<Fence>(new Fence(context)));
+	}
+	else
+	{
+		m_ClientCopy.resize(size());
+		m_Mapping = &m_ClientCopy[0];
+	}
+}
+
+StreamBuffer::~StreamBuffer()
+{
+	// Deleting the buffer unmaps it.
+}
+
+void StreamBuffer::enterContext( Context* context )
+{
+	Buffer::enterContext(context);
+
+	for(int i = 0; i < m_Fences.size(); ++i)
+		m_Fences[i]->moveTo(context);
+}
+
+void StreamBuffer::allocateStorage( const void* data )
+{
+	if(!m_Persistent)
+	{
+		Buffer::allocateStorage(data);
+		return;
+	}
+
+	// Immutable storage can't be orphaned.
+	assert(m_Mapping == NULL);
+
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	if(context()->m_DirectStateAccess)
+	{
+		context()->gl().NamedBufferStorage(m_Handle, size(), data, flags);
+		m_Mapping = (char*)context()->gl().MapNamedBufferRange(m_Handle, 0, size(), flags);
+	}
+	else
+	{
+		GLenum editTarget = context()->bindBufferForEdit(this);
+		context()->gl().BufferStorage(editTarget, size(), data, flags);
+		m_Mapping = (char*)context()->gl().MapBufferRange(editTarget, 0, size(), flags);
+	}
+
+	if(!m_Mapping)
+		FatalError("Can't map stream buffer persistently.");
+}
+
+void* StreamBuffer::allocate( int count, int* first )
+{
+	assert(count >= 0);
+	if(m_Offset+count > m_RegionSize)
+		FatalError("Stream buffer region exhausted: %d of %d elements used, %d requested", m_Offset, m_RegionSize, count);
+
+	ensureStorage(NULL);
+
+	*first = m_Region*m_RegionSize + m_Offset;
+	m_Offset += count;
+
+	// The client copy is counted when committing.
+	if(m_Persistent)
+		context()->m_Stats.bufferBytesUploaded += count*elementSize();
+
+	return m_Mapping + (*first)*elementSize();
+}
+
+void StreamBuffer::commit()
+{
+	if(m_Persistent || m_Offset == m_CommitOffset)
+		return;
+
+	int start = m_Region*m_RegionSize + m_CommitOffset;
+	copyFrom(m_Mapping + start*elementSize(), m_Offset-m_CommitOffset, start);
+	m_CommitOffset = m_Offset;
+}
+
+void StreamBuffer::endFrame()
+{
+	commit();
+
+	if(m_Persistent)
+		m_Fences[m_Region]->insert();
+
+	m_Region = (m_Region+1) % m_RegionCount;
+	m_Offset = 0;
+	m_CommitOffset = 0;
+
+	if(m_Persistent)
+	{
+		Fence* fence = m_Fences[m_Region].get();
+		if(!fence->isSignaled())
+		{
+			++context()->m_Stats.streamBufferStalls;
+			fence->wait();
+		}
+	}
+	else if(m_Region == 0 && hasStorage())
+	{
+		// Draws of the previous frames keep their storage.
+		Buffer::allocateStorage(NULL);
+	}
+}
+
+bool StreamBuffer::isPersistent() const
+{
+	return m_Persistent;
+}
+
+int StreamBuffer::regionSize() const
+{
+	return m_RegionSize;
+}
+
+int StreamBuffer::regionCount() const
+{
+	return m_RegionCount;
+}
+
+}
+}
@@ -0,0 +1,85 @@
+#ifndef __SPARKPLUG_GL_STREAM_BUFFER__
+#define __SPARKPLUG_GL_STREAM_BUFFER__
+
+#include <vector>
+#include <memory>
+#include <SparkPlug/GL/Buffer.h>
+#include <SparkPlug/GL/Fence.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/**
+ * Ring of per frame regions for data which is rewritten every frame.
+ *
+ * With ARB_buffer_storage the buffer stays mapped persistently and
+ * a region is only written again after the GPU passed the fence
+ * of the frame which last used it.
+ * Otherwise allocations are written to a client side copy and uploaded
+ * by commit(). The storage is orphaned whenever the ring wraps around.
+ *
+ * Use allocate() instead of map() or copyFrom().
+ */
+class StreamBuffer : public Buffer
+{
+public:
+	/**
+	 * regionSize is the number of elements available per frame.
+	 */
+	static StrongRef<StreamBuffer> Create( Context* context, BufferTarget target, int elementSize, int regionSize, int regionCount = 3 );
+
+	virtual ~StreamBuffer();
+
+	/**
+	 * Moves the fences too.
+	 */
+	virtual void enterContext( Context* context );
+
+	/**
+	 * Reserves count elements in the region of the current frame.
+	 * Returns where to write them, first receives the index of the first one
+	 * as expected by Context::draw() and Context::drawElements().
+	 */
+	void* allocate( int count, int* first );
+
+	/**
+	 * Makes the allocations written since the last commit visible to OpenGL.
+	 * Call it before drawing from them.
+	 */
+	void commit();
+
+	/**
+	 * Commits and fences the region of this frame, then moves on to the next one.
+	 * Waits if the GPU is still reading from it.
+	 */
+	void endFrame();
+
+	bool isPersistent() const;
+	int regionSize() const;
+	int regionCount() const;
+
+protected:
+	StreamBuffer( Context* context, BufferTarget target, int elementSize, int regionSize, int regionCount );
+
+	virtual void allocateStorage( const void* data );
+
+private:
+	bool m_Persistent;
+	int m_RegionSize;
+	int m_RegionCount;
+	int m_Region; // Current one
+	int m_Offset; // First free element of the current region
+	int m_CommitOffset; // First element of the current region which wasn't uploaded yet, client copy only
+
+	char* m_Mapping; // Persistent mapping or client copy
+	std::vector<char> m_ClientCopy;
+	std::vector< std::unique_ptr<Fence> > m_Fences; // One per region, persistent mapping only
+};
+
+}
+}
+
+#endif
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <SparkPlug/Common.h>
 #include <SparkPlug/Math.h>
 #include <SparkPlug/Pixel.h>
@@ -42,7 +43,25 @@ void SamplerBase::setMaxAnisotropic( float level )
 	m_MaxAnisotropic = level;
 }
 
-bool Texture::UploadTextureRaw( TextureType type, bool proxy, int level, const PixelFormat& format, bool sRGB, int width, int height, int depth, bool border, const void* data )
+/**
+ * Length of the full mip map chain.
+ */
+int MipMapLevelCount( TextureType type, int width, int height, int depth )
+{
+	if(type == TextureType_Rect)
+		return 1;
+
+	int size = std::max(width, std::max(height, depth));
+	int levels = 1;
+	while(size > 1)
+	{
+		size >>= 1;
+		++levels;
+	}
+	return levels;
+}
+
+bool Texture::UploadTextureRaw( Context* context, TextureType type, bool proxy, int level, const PixelFormat& format, bool sRGB, int width, int height, int depth, bool border, const void* data )
 {
 	GLenum typeGL   = proxy ? ConvertToProxyGL(type) : ConvertToGL(type);
 	GLenum formatGL = ConvertToGL(format, sRGB);
@@ -53,25 +72,30 @@ bool Texture::UploadTextureRaw( TextureType type, bool proxy, int level, const P
 	switch(type)
 	{
 		case TextureType_1D:
-			glTexImage1D(typeGL, level, formatGL, width, borderGL, semanticGL, componentTypeGL, data);
+			context->gl().TexImage1D(typeGL, level, formatGL, width, borderGL, semanticGL, componentTypeGL, data);
 			break;
 		
 		case TextureType_3D:
-			glTexImage3D(typeGL, level, formatGL, width, height, depth, borderGL, semanticGL, componentTypeGL, data);
+			context->gl().TexImage3D(typeGL, level, formatGL, width, height, depth, borderGL, semanticGL, componentTypeGL, data);
 			break;
 		
 		case TextureType_2D:
 		case TextureType_Rect:
 		case TextureType_CubeMap:
-			glTexImage2D(typeGL, level, formatGL, width, height, borderGL, semanticGL, componentTypeGL, data);
+			context->gl().TexImage2D(typeGL, level, formatGL, width, height, borderGL, semanticGL, componentTypeGL, data);
 			break;
 		
 		default:
 			FatalError("Invalid texture type: %u", type);
 	}
 	
+	// Only proxies report failures, reading back a real upload would stall.
+	// Its errors surface through SPARKPLUG_GL_CHECK instead.
+	if(!proxy)
+		return true;
+
 	GLint realWidth;
-	glGetTexLevelParameteriv(typeGL, 0, GL_TEXTURE_WIDTH, &realWidth);
+	context->gl().GetTexLevelParameteriv(typeGL, 0, GL_TEXTURE_WIDTH, &realWidth);
 	
 	if(realWidth == 0)
 	{
@@ -83,18 +107,88 @@ bool Texture::UploadTextureRaw( TextureType type, bool proxy, int level, const P
 	return true;
 }
 
-bool Texture::TestTextureCreation( TextureType type, int width, int height, int depth, PixelFormat format, bool sRGB )
+void Texture::UploadTextureStorage( Context* context, GLuint handle, TextureType type, int levels, const PixelFormat& format, bool sRGB, int width, int height, int depth, const void* data )
 {
-	return UploadTextureRaw(
-			type,
-			true, // proxy
-			0,    // level
-			format,
-			sRGB,
-			width, height, depth,
-			false, // border
-			NULL
-	);
+	GLenum formatGL = ConvertToGL(format, sRGB);
+	GLenum semanticGL      = ConvertToGL(format.semantic());
+	GLenum componentTypeGL = ConvertToGL(format.componentType());
+
+	switch(type)
+	{
+		case TextureType_1D:
+			context->gl().TextureStorage1D(handle, levels, formatGL, width);
+			context->gl().TextureSubImage1D(handle, 0, 0, width, semanticGL, componentTypeGL, data);
+			break;
+
+		case TextureType_3D:
+			context->gl().TextureStorage3D(handle, levels, formatGL, width, height, depth);
+			context->gl().TextureSubImage3D(handle, 0, 0, 0, 0, width, height, depth, semanticGL, componentTypeGL, data);
+			break;
+
+		case TextureType_2D:
+		case TextureType_Rect:
+			context->gl().TextureStorage2D(handle, levels, formatGL, width, height);
+			context->gl().TextureSubImage2D(handle, 0, 0, 0, width, height, semanticGL, componentTypeGL, data);
+			break;
+
+		case TextureType_CubeMap:
+			// The faces are the layers of the image.
+			context->gl().TextureStorage2D(handle, levels, formatGL, width, height);
+			context->gl().TextureSubImage3D(handle, 0, 0, 0, 0, width, height, depth, semanticGL, componentTypeGL, data);
+			break;
+
+		default:
+			FatalError("Invalid texture type: %u", type);
+	}
+}
+
+bool Texture::TestTextureCreation( Context* context, TextureType type, int width, int height, int depth, PixelFormat format, bool sRGB )
+{
+	// Answered from the capabilities, so only unknown formats are probed.
+	int size = std::max(width, height);
+	if(type == TextureType_3D)
+		size = std::max(size, depth);
+	if(size > context->limits().maxTextureSize[type])
+	{
+		LogError("Cannot create %s texture:", AsString(type));
+		LogError("Size: %d, %d, %d exceeds %d", width, height, depth, context->limits().maxTextureSize[type]);
+		return false;
+	}
+
+	GLenum formatGL = ConvertToGL(format, sRGB);
+	int supported = context->m_Capabilities.formatSupport(type, formatGL);
+	if(supported == -1)
+	{
+		if(context->m_Capabilities.hasFeature(Feature_InternalFormatQuery2))
+		{
+			GLint result = GL_FALSE;
+			context->gl().GetInternalformativ(ConvertToGL(type), formatGL, GL_INTERNALFORMAT_SUPPORTED, 1, &result);
+			supported = (result == GL_TRUE) ? 1 : 0;
+		}
+		else
+		{
+			supported = UploadTextureRaw(
+				context,
+				type,
+				true, // proxy
+				0,    // level
+				format,
+				sRGB,
+				1, 1, 1,
+				false, // border
+				NULL
+			) ? 1 : 0;
+		}
+		context->m_Capabilities.setFormatSupport(type, formatGL, supported == 1);
+	}
+
+	if(!supported)
+	{
+		LogError("Cannot create %s texture:", AsString(type));
+		LogError("Format: %s (sRGB=%d) is not supported", format.asString().c_str(), (int)sRGB);
+		return false;
+	}
+	return true;
 }
 
 StrongRef<Texture> Texture::Create( Context* context, TextureType type )
@@ -109,17 +203,37 @@ StrongRef<Texture> Texture::CreateFromImage( Context* context, TextureType type,
 	bool border = false;
 	StrongRef<Texture> texture = new Texture(context, type);
 	
-	TextureBinding binding(context, context->activeTextureUnit(), texture);
-	
-	if(!TestTextureCreation(type, image.width(), image.height(), image.depth(), image.format(), sRGB))
+	if(!TestTextureCreation(context, type, image.width(), image.height(), image.depth(), image.format(), sRGB))
 	{
 		return NULL;
 	}
 	
-	GLenum texType = ConvertToGL(type);
-	
+	texture->m_Width  = image.width();
+	texture->m_Height = image.height();
+	texture->m_Depth  = image.depth();
+	texture->m_MipMapLevels = MipMapLevelCount(type, image.width(), image.height(), image.depth());
 	
-	if(!UploadTextureRaw(
+	if(context->m_DirectStateAccess)
+	{
+		UploadTextureStorage(
+			context,
+			texture->handle(),
+			type,
+			texture->m_MipMapLevels,
+			image.format(),
+			sRGB,
+			image.width(), image.height(), image.depth(),
+			image.pixels()
+		);
+		if(texture->hasMipMaps())
+			context->gl().GenerateTextureMipmap(texture->handle());
+	}
+	else
+	{
+		context->bindTextureForEdit(texture);
+		
+		UploadTextureRaw(
+			context,
 			type,
 			false, // proxy
 			0,     // level
@@ -128,39 +242,43 @@ StrongRef<Texture> Texture::CreateFromImage( Context* context, TextureType type,
 			image.width(), image.height(), image.depth(),
 			border,
 			image.pixels()
-	))
-	{
-		// Meep something went wrong :(
-		return NULL;
+		);
 	}
 	
-	CheckGl();
+	context->m_Stats.textureBytesUploaded += image.width()*image.height()*image.depth()*image.format().pixelSize();
+	
+	// The minification filter depends on the mip maps.
+	texture->setParameter(GL_TEXTURE_MIN_FILTER, ConvertToGL(texture->filter(), texture->hasMipMaps()));
+	
+	SPARKPLUG_GL_CHECK_CALL_SITE(context->gl());
 	
 	return texture;
 }
 
 Texture::Texture( Context* context, TextureType type ) :
-	SamplerBase(context),
-	m_Type(type)
+	SamplerBase(context, ObjectType_Texture),
+	m_Type(type),
+	m_MipMapLevels(1),
+	m_Width(0),
+	m_Height(0),
+	m_Depth(0)
 {
 	enterImmortalSection();
 	
-	glGenTextures(1, &m_Handle);
+	m_Handle = context->m_NamePool.acquire(NameKind(NameKind_FirstTexture + type));
 	
 	setAddressMode(TextureAddressMode_Clamp);
 	setFilter(TextureFilter_Trilinear);
 	
-	{
-		TextureBinding binding(context, context->activeTextureUnit(), this);
-		glTexParameteri(ConvertToGL(type), GL_GENERATE_MIPMAP, GL_TRUE);
-	}
+	// Mip maps are generated explicitly after uploading with direct state access.
+	if(!context->m_DirectStateAccess)
+		setParameter(GL_GENERATE_MIPMAP, GL_TRUE);
 	
 	leaveImmortalSection();
 }
 
 Texture::~Texture()
 {
-	glDeleteTextures(1, &m_Handle);
 }
 
 TextureType Texture::type() const
@@ -190,9 +308,8 @@ void Texture::setFilter( TextureFilter f )
 {
 	if(f == filter())
 		return;
-	TextureBinding binding(context(), context()->activeTextureUnit(), this);
-	glTexParameteri(ConvertToGL(type()), GL_TEXTURE_MIN_FILTER, ConvertToGL(f, hasMipMaps()));
-	glTexParameteri(ConvertToGL(type()), GL_TEXTURE_MAG_FILTER, ConvertToGL(f, false));
+	setParameter(GL_TEXTURE_MIN_FILTER, ConvertToGL(f, hasMipMaps()));
+	setParameter(GL_TEXTURE_MAG_FILTER, ConvertToGL(f, false));
 	SamplerBase::setFilter(f);
 }
 
@@ -200,10 +317,9 @@ void Texture::setAddressMode( TextureAddressMode m )
 {
 	if(m == addressMode())
 		return;
-	TextureBinding binding(context(), context()->activeTextureUnit(), this);
-	glTexParameteri(ConvertToGL(type()), GL_TEXTURE_WRAP_S, ConvertToGL(m));
-	glTexParameteri(ConvertToGL(type()), GL_TEXTURE_WRAP_T, ConvertToGL(m));
-	glTexParameteri(ConvertToGL(type()), GL_TEXTURE_WRAP_R, ConvertToGL(m));
+	setParameter(GL_TEXTURE_WRAP_S, ConvertToGL(m));
+	setParameter(GL_TEXTURE_WRAP_T, ConvertToGL(m));
+	setParameter(GL_TEXTURE_WRAP_R, ConvertToGL(m));
 	SamplerBase::setAddressMode(m);
 }
 
@@ -211,9 +327,35 @@ void Texture::setMaxAnisotropic( float level )
 {
 	if(level == maxAnisotropic())
 		return;
-	glTexParameteri(ConvertToGL(type()), GL_TEXTURE_MAX_ANISOTROPY_EXT, level);
+	setFloatParameter(GL_TEXTURE_MAX_ANISOTROPY_EXT, level);
 	SamplerBase::setMaxAnisotropic(level);
 }
 
+void Texture::setParameter( GLenum name, GLint value )
+{
+	if(context()->m_DirectStateAccess)
+	{
+		context()->gl().TextureParameteri(m_Handle, name, value);
+	}
+	else
+	{
+		context()->bindTextureForEdit(this);
+		context()->gl().TexParameteri(ConvertToGL(m_Type), name, value);
+	}
+}
+
+void Texture::setFloatParameter( GLenum name, float value )
+{
+	if(context()->m_DirectStateAccess)
+	{
+		context()->gl().TextureParameterf(m_Handle, name, value);
+	}
+	else
+	{
+		context()->bindTextureForEdit(this);
+		context()->gl().TexParameterf(ConvertToGL(m_Type), name, value);
+	}
+}
+
 }
 }
@@ -21,7 +21,7 @@ namespace GL
 class SamplerBase : public Object
 {
 public:
-	SamplerBase( Context* context ) : Object(context) {}
+	SamplerBase( Context* context, ObjectType type ) : Object(context, type) {}
 	virtual ~SamplerBase() {}
 
 	TextureFilter filter() const;
@@ -42,8 +42,17 @@ private:
 class Texture : public SamplerBase
 {
 public:
+	static const ObjectType PoolType = ObjectType_Texture;
+
 	static StrongRef<Texture> Create( Context* context, TextureType type );
+
+	/**
+	 * Returns NULL if the size or format isn't supported.
+	 * Failures of the upload itself, like running out of memory,
+	 * are only reported by the checks selected with SPARKPLUG_GL_CHECK.
+	 */
 	static StrongRef<Texture> CreateFromImage( Context* context, TextureType type, const Image& image );
+
 	virtual ~Texture();
 	
 	TextureType type() const;
@@ -58,8 +67,16 @@ public:
 	
 private:
 	Texture( Context* context, TextureType type );
-	static bool UploadTextureRaw( TextureType type, bool proxy, int level, const PixelFormat& format, bool sRGB, int width, int height, int depth, bool border, const void* data );
-	static bool TestTextureCreation( TextureType type, int width, int height, int depth, PixelFormat format, bool sRGB );
+	static bool UploadTextureRaw( Context* context, TextureType type, bool proxy, int level, const PixelFormat& format, bool sRGB, int width, int height, int depth, bool border, const void* data );
+	static bool TestTextureCreation( Context* context, TextureType type, int width, int height, int depth, PixelFormat format, bool sRGB );
+	static void UploadTextureStorage( Context* context, GLuint handle, TextureType type, int levels, const PixelFormat& format, bool sRGB, int width, int height, int depth, const void* data );
+	
+	/**
+	 * Edits the texture by name if direct state access is available,
+	 * otherwise it is bound first.
+	 */
+	void setParameter( GLenum name, GLint value );
+	void setFloatParameter( GLenum name, float value );
 	
 	TextureType m_Type;
 	int         m_MipMapLevels;
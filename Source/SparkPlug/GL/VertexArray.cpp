@@ -0,0 +1,164 @@
+#include <vector>
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/Context.h>
+#include <SparkPlug/GL/VertexArray.h>
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+/// ---- Key ----
+
+bool VertexArrayCache::Key::operator < ( const Key& other ) const
+{
+	if(formatHash != other.formatHash)
+		return formatHash < other.formatHash;
+	if(vertexBuffer != other.vertexBuffer)
+		return vertexBuffer < other.vertexBuffer;
+	if(instanceBuffer != other.instanceBuffer)
+		return instanceBuffer < other.instanceBuffer;
+	if(indexBuffer != other.indexBuffer)
+		return indexBuffer < other.indexBuffer;
+	return offset < other.offset;
+}
+
+
+/// ---- VertexArrayCache ----
+
+VertexArrayCache::VertexArrayCache( Context* context ) :
+	m_Context(context)
+{
+}
+
+VertexArrayCache::~VertexArrayCache()
+{
+	clear();
+}
+
+VertexArrayCache::Key VertexArrayCache::MakeKey( const VertexFormat& format, GLuint vertexBuffer, GLuint instanceBuffer, GLuint indexBuffer, const void* offset )
+{
+	Key key;
+	key.formatHash     = format.hash();
+	key.vertexBuffer   = vertexBuffer;
+	key.instanceBuffer = instanceBuffer;
+	key.indexBuffer    = indexBuffer;
+	key.offset         = offset;
+	return key;
+}
+
+GLuint VertexArrayCache::find( const VertexFormat& format, GLuint vertexBuffer, GLuint instanceBuffer, GLuint indexBuffer, const void* offset ) const
+{
+	std::map<Key, Entry>::const_iterator i = m_Entries.find(MakeKey(format, vertexBuffer, instanceBuffer, indexBuffer, offset));
+	if(i == m_Entries.end())
+		return 0;
+
+	// Hash collision
+	if(i->second.format != format)
+		return 0;
+
+	return i->second.vertexArray;
+}
+
+void VertexArrayCache::insert( const VertexFormat& format, GLuint vertexBuffer, GLuint instanceBuffer, GLuint indexBuffer, const void* offset, GLuint vertexArray )
+{
+	assert(vertexArray != 0);
+
+	Key key = MakeKey(format, vertexBuffer, instanceBuffer, indexBuffer, offset);
+
+	std::map<Key, Entry>::iterator i = m_Entries.find(key);
+	if(i != m_Entries.end())
+	{
+		// Replace the colliding entry, buffer links stay the same.
+		m_Context->gl().DeleteVertexArrays(1, &i->second.vertexArray);
+		i->second.format = format;
+		i->second.vertexArray = vertexArray;
+		return;
+	}
+
+	Entry entry;
+	entry.format = format;
+	entry.vertexArray = vertexArray;
+	m_Entries.insert(std::make_pair(key, entry));
+
+	// Each referenced buffer is linked once.
+	if(vertexBuffer)
+		m_BufferUsers.insert(std::make_pair(vertexBuffer, key));
+	if(instanceBuffer && instanceBuffer != vertexBuffer)
+		m_BufferUsers.insert(std::make_pair(instanceBuffer, key));
+	if(indexBuffer && indexBuffer != vertexBuffer && indexBuffer != instanceBuffer)
+		m_BufferUsers.insert(std::make_pair(indexBuffer, key));
+}
+
+void VertexArrayCache::unlinkBuffer( GLuint buffer, const Key& key )
+{
+	typedef std::multimap<GLuint, Key>::iterator Iter;
+	std::pair<Iter, Iter> range = m_BufferUsers.equal_range(buffer);
+	for(Iter i = range.first; i != range.second; ++i)
+	{
+		if(!(i->second < key) && !(key < i->second))
+		{
+			m_BufferUsers.erase(i);
+			return;
+		}
+	}
+}
+
+bool VertexArrayCache::releaseBuffer( GLuint buffer, GLuint boundVertexArray )
+{
+	typedef std::multimap<GLuint, Key>::iterator Iter;
+	std::pair<Iter, Iter> range = m_BufferUsers.equal_range(buffer);
+	if(range.first == range.second)
+		return false;
+
+	std::vector<Key> keys;
+	for(Iter i = range.first; i != range.second; ++i)
+		keys.push_back(i->second);
+	m_BufferUsers.erase(range.first, range.second);
+
+	bool releasedBound = false;
+	std::vector<GLuint> vertexArrays;
+	for(std::vector<Key>::const_iterator i = keys.begin(); i != keys.end(); ++i)
+	{
+		std::map<Key, Entry>::iterator entry = m_Entries.find(*i);
+		assert(entry != m_Entries.end());
+
+		if(entry->second.vertexArray == boundVertexArray)
+			releasedBound = true;
+		vertexArrays.push_back(entry->second.vertexArray);
+		m_Entries.erase(entry);
+
+		// Forget the key at the other buffers too
+		if(i->vertexBuffer != buffer && i->vertexBuffer)
+			unlinkBuffer(i->vertexBuffer, *i);
+		if(i->instanceBuffer != buffer && i->instanceBuffer && i->instanceBuffer != i->vertexBuffer)
+			unlinkBuffer(i->instanceBuffer, *i);
+		if(i->indexBuffer != buffer && i->indexBuffer && i->indexBuffer != i->vertexBuffer && i->indexBuffer != i->instanceBuffer)
+			unlinkBuffer(i->indexBuffer, *i);
+	}
+
+	m_Context->gl().DeleteVertexArrays(vertexArrays.size(), &vertexArrays[0]);
+	return releasedBound;
+}
+
+void VertexArrayCache::clear()
+{
+	std::vector<GLuint> vertexArrays;
+	std::map<Key, Entry>::const_iterator i = m_Entries.begin();
+	for(; i != m_Entries.end(); ++i)
+		vertexArrays.push_back(i->second.vertexArray);
+
+	if(!vertexArrays.empty())
+		m_Context->gl().DeleteVertexArrays(vertexArrays.size(), &vertexArrays[0]);
+
+	m_Entries.clear();
+	m_BufferUsers.clear();
+}
+
+int VertexArrayCache::size() const
+{
+	return m_Entries.size();
+}
+
+}
+}
@@ -0,0 +1,79 @@
+#ifndef __SPARKPLUG_GL_VERTEX_ARRAY__
+#define __SPARKPLUG_GL_VERTEX_ARRAY__
+
+#include <map>
+#include <SparkPlug/GL/OpenGL.h>
+#include <SparkPlug/GL/VertexFormat.h>
+
+
+namespace SparkPlug
+{
+namespace GL
+{
+
+class Context;
+
+/**
+ * Maps (vertex format, vertex buffer, instance buffer, index buffer, base offset)
+ * to a fully configured vertex array object.
+ * The cache owns the vertex array objects it stores.
+ */
+class VertexArrayCache
+{
+public:
+	VertexArrayCache( Context* context );
+	~VertexArrayCache();
+
+	/**
+	 * Returns the vertex array which was stored for the given setup
+	 * or 0 if there is none yet.
+	 */
+	GLuint find( const VertexFormat& format, GLuint vertexBuffer, GLuint instanceBuffer, GLuint indexBuffer, const void* offset ) const;
+
+	void insert( const VertexFormat& format, GLuint vertexBuffer, GLuint instanceBuffer, GLuint indexBuffer, const void* offset, GLuint vertexArray );
+
+	/**
+	 * Deletes every vertex array that references the given buffer.
+	 * Must be called before the buffer name is released,
+	 * since the driver may hand it out again.
+	 * @return Whether boundVertexArray was one of the deleted arrays.
+	 */
+	bool releaseBuffer( GLuint buffer, GLuint boundVertexArray );
+
+	void clear();
+	int size() const;
+
+private:
+	VertexArrayCache( const VertexArrayCache& source );
+	VertexArrayCache& operator = ( const VertexArrayCache& source );
+
+	Context* m_Context;
+
+	struct Key
+	{
+		unsigned int formatHash;
+		GLuint vertexBuffer;
+		GLuint instanceBuffer;
+		GLuint indexBuffer;
+		const void* offset;
+
+		bool operator < ( const Key& other ) const;
+	};
+
+	struct Entry
+	{
+		VertexFormat format;
+		GLuint vertexArray;
+	};
+
+	static Key MakeKey( const VertexFormat& format, GLuint vertexBuffer, GLuint instanceBuffer, GLuint indexBuffer, const void* offset );
+	void unlinkBuffer( GLuint buffer, const Key& key );
+
+	std::map<Key, Entry>     m_Entries;
+	std::multimap<GLuint, Key> m_BufferUsers; // Buffer -> keys that reference it
+};
+
+}
+}
+
+#endif
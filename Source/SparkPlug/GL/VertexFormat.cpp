@@ -1,6 +1,7 @@
 #include <cctype>
 #include <cstring>
 #include <SparkPlug/GL/VertexFormat.h>
+#include <SparkPlug/GL/Hash.h>
 
 
 namespace SparkPlug
@@ -11,14 +12,17 @@ namespace GL
 
 /// ---- VertexAttribute ----
 
-VertexAttribute::VertexAttribute()
+VertexAttribute::VertexAttribute() :
+	m_Normalized(false),
+	m_PerInstance(false)
 {
 }
 
-VertexAttribute::VertexAttribute( const char* name, const DataType& type, bool normalize ) :
+VertexAttribute::VertexAttribute( const char* name, const DataType& type, bool normalize, bool perInstance ) :
 	m_Name(name),
 	m_Type(type),
-	m_Normalized(normalize)
+	m_Normalized(normalize),
+	m_PerInstance(perInstance)
 {
 }
 
@@ -36,13 +40,14 @@ VertexAttribute::~VertexAttribute()
 {
 }
 
-// "Position:vec3f TexCoord:nvec2I"
+// "Position:vec3f TexCoord:nvec2I Transform:imat4f"
 void VertexAttribute::setByDef( const char* def, int length )
 {
 	std::vector<char> buf;
 	DataType type;
 	
 	m_Normalized = false;
+	m_PerInstance = false;
 	int mode = 0;
 	
 	for(int i = 0; i < length; ++i)
@@ -70,6 +75,10 @@ void VertexAttribute::setByDef( const char* def, int length )
 				{
 					m_Normalized = true;
 				}
+				else if(ch == 'i' && buf.size() == 0 && i < length-1) // A lone i is an int
+				{
+					m_PerInstance = true;
+				}
 				else
 				{
 					buf.push_back(ch);
@@ -92,7 +101,8 @@ bool VertexAttribute::operator == ( const VertexAttribute& format ) const
 	return
 		(m_Name == format.m_Name) &&
 		(m_Type == format.m_Type) &&
-		(m_Normalized == format.m_Normalized);
+		(m_Normalized == format.m_Normalized) &&
+		(m_PerInstance == format.m_PerInstance);
 }
 
 bool VertexAttribute::operator != ( const VertexAttribute& format ) const
@@ -115,9 +125,24 @@ bool VertexAttribute::isNormalized() const
 	return m_Normalized;
 }
 
+bool VertexAttribute::isPerInstance() const
+{
+	return m_PerInstance;
+}
+
+int VertexAttribute::locationCount() const
+{
+	if(m_Type.compositeType() == CompositeDataType_Matrix)
+		return m_Type.compositeSize();
+	else
+		return 1;
+}
+
 std::string VertexAttribute::asString() const
 {
 	std::string buf = m_Name+":";
+	if(m_PerInstance)
+		buf += "i";
 	if(m_Normalized)
 		buf += "n";
 	return buf+m_Type.toString();
@@ -126,11 +151,25 @@ std::string VertexAttribute::asString() const
 
 /// ---- VertexFormat ----
 
-VertexFormat::VertexFormat()
+static unsigned int HashAttribute( unsigned int hash, const VertexAttribute& attribute )
 {
+	const DataType& type = attribute.dataType();
+	hash = Hash(hash, attribute.name());
+	hash = Hash(hash, (unsigned int)type.primitveType());
+	hash = Hash(hash, (unsigned int)type.compositeType());
+	hash = Hash(hash, (unsigned int)type.compositeSize());
+	hash = Hash(hash, (unsigned int)attribute.isNormalized());
+	hash = Hash(hash, (unsigned int)attribute.isPerInstance());
+	return hash;
 }
 
-VertexFormat::VertexFormat( const char* def )
+VertexFormat::VertexFormat() :
+	m_Hash(HashSeed)
+{
+}
+
+VertexFormat::VertexFormat( const char* def ) :
+	m_Hash(HashSeed)
 {
 	int begin = 0;
 	int i = 0;
@@ -164,13 +203,15 @@ VertexFormat::VertexFormat( const char* def )
 }
 
 VertexFormat::VertexFormat( const VertexFormat& source ) :
-	m_Attributes(source.m_Attributes)
+	m_Attributes(source.m_Attributes),
+	m_Hash(source.m_Hash)
 {
 }
 
 VertexFormat& VertexFormat::operator=( const VertexFormat& source )
 {
 	m_Attributes = source.m_Attributes;
+	m_Hash = source.m_Hash;
 	return *this;
 }
 
@@ -181,7 +222,9 @@ bool VertexFormat::isValid() const
 
 bool VertexFormat::operator==( const VertexFormat& format ) const
 {
-	return m_Attributes == format.m_Attributes;
+	return
+		(m_Hash == format.m_Hash) &&
+		(m_Attributes == format.m_Attributes);
 }
 
 bool VertexFormat::operator!=( const VertexFormat& format ) const
@@ -202,6 +245,7 @@ const VertexAttribute& VertexFormat::attribute( int i ) const
 void VertexFormat::appendAttribute( const VertexAttribute& attribute )
 {
 	m_Attributes.push_back(attribute);
+	m_Hash = HashAttribute(m_Hash, attribute);
 }
 
 int VertexFormat::sizeInBytes() const
@@ -213,6 +257,53 @@ int VertexFormat::sizeInBytes() const
 	return bytes;
 }
 
+int VertexFormat::vertexStride() const
+{
+	int bytes = 0;
+	std::vector<VertexAttribute>::const_iterator i = m_Attributes.begin();
+	for(; i != m_Attributes.end(); ++i)
+		if(!i->isPerInstance())
+			bytes += i->dataType().sizeInBytes();
+	return bytes;
+}
+
+int VertexFormat::instanceStride() const
+{
+	return sizeInBytes() - vertexStride();
+}
+
+bool VertexFormat::hasInstanceAttributes() const
+{
+	std::vector<VertexAttribute>::const_iterator i = m_Attributes.begin();
+	for(; i != m_Attributes.end(); ++i)
+		if(i->isPerInstance())
+			return true;
+	return false;
+}
+
+int VertexFormat::attributeLocation( int i ) const
+{
+	assert(InsideArray(i, attributeCount()));
+	int location = 0;
+	for(int j = 0; j < i; ++j)
+		location += m_Attributes[j].locationCount();
+	return location;
+}
+
+int VertexFormat::locationCount() const
+{
+	int count = 0;
+	std::vector<VertexAttribute>::const_iterator i = m_Attributes.begin();
+	for(; i != m_Attributes.end(); ++i)
+		count += i->locationCount();
+	return count;
+}
+
+unsigned int VertexFormat::hash() const
+{
+	return m_Hash;
+}
+
 std::string VertexFormat::asString() const
 {
 	std::string buf("(");
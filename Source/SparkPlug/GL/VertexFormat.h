@@ -17,7 +17,7 @@ class VertexAttribute
 {
 public:
 	VertexAttribute();
-	VertexAttribute( const char* name, const DataType& type, bool normalize );
+	VertexAttribute( const char* name, const DataType& type, bool normalize, bool perInstance = false );
 	VertexAttribute( const char* def, int length );
 	VertexAttribute( const char* def );
 	virtual ~VertexAttribute();
@@ -29,6 +29,17 @@ public:
 	const DataType& dataType() const;
 	bool isNormalized() const;
 	
+	/**
+	 * Per instance attributes advance once per instance instead of once per vertex.
+	 * They are marked with an i prefix in definitions: "Transform:imat4f"
+	 */
+	bool isPerInstance() const;
+	
+	/**
+	 * Matrices occupy one location per column.
+	 */
+	int locationCount() const;
+	
 	std::string asString() const;
 	
 private:
@@ -37,6 +48,7 @@ private:
 	std::string m_Name;
 	   DataType m_Type;
 	       bool m_Normalized;
+	       bool m_PerInstance;
 };
 
 
@@ -59,6 +71,26 @@ public:
 
 	int sizeInBytes() const;
 	
+	/**
+	 * Per vertex and per instance attributes are read from separate buffers,
+	 * each one interleaved with its own stride.
+	 */
+	int vertexStride() const;
+	int instanceStride() const;
+	bool hasInstanceAttributes() const;
+	
+	/**
+	 * First location used by attribute i.
+	 */
+	int attributeLocation( int i ) const;
+	int locationCount() const;
+	
+	/**
+	 * Cheap hash of all attributes.
+	 * Equal formats have equal hashes, but not vice versa.
+	 */
+	unsigned int hash() const;
+	
 	std::string asString() const;
 	
 	
@@ -72,6 +104,7 @@ public:
 	
 private:
 	std::vector<VertexAttribute> m_Attributes;
+	unsigned int m_Hash;
 };
 
 }
@@ -0,0 +1,336 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <vector>
+#include <SparkPlug/Common.h>
+#include <SparkPlug/Image.h>
+#include <SparkPlug/ImageIo/Loader.h>
+#include <SparkPlug/GL/Context.h>
+#include <SparkPlug/GL/Dispatch.h>
+#include <SparkPlug/GL/HeadlessContext.h>
+#include <SparkPlug/GL/NullDispatch.h>
+#include <SparkPlug/GL/Shader.h>
+#include <SparkPlug/GL/Texture.h>
+#include <SparkPlug/GL/Buffer.h>
+#include <SparkPlug/GL/StreamBuffer.h>
+#include <SparkPlug/GL/VertexFormat.h>
+#include <SparkPlug/GL/DataType.h>
+
+namespace sp = SparkPlug;
+
+/**
+ * Usage: sparkplug-gl-bench [--iterations N] [--buffer-size BYTES] [--image FILE] [--headless]
+ *
+ * Prints one JSON object per benchmark and line:
+ * {"benchmark": ..., "iterations": ..., "ns_per_op": ..., "gl_calls_per_op": ...}
+ *
+ * Runs on the null backend by default, so it measures the CPU overhead
+ * of the library alone and needs neither a GPU nor a window.
+ * With --headless it runs on a HeadlessContext instead,
+ * so the driver's share is included. That needs a build with EGL.
+ *
+ * gl_calls_per_op differs between the two. The null backend reports
+ * OpenGL 2.1 without extensions. A real driver usually offers direct state
+ * access, multi-bind and vertex array objects, which change the calls the
+ * library makes. Compare call counts only between runs on the same backend.
+ *
+ * Bind benchmarks include a draw, which commits the bindings.
+ * Subtract the plain draw benchmark to get the bind cost.
+ */
+
+struct Options
+{
+	int iterations;
+	int bufferSize;
+	const char* image;
+	bool headless;
+};
+
+const char* VertexShaderSource =
+	"#version 120\n"
+	"attribute vec3 Position;\n"
+	"void main() { gl_Position = vec4(Position, 1.0); }\n";
+
+const char* FragmentShaderSource =
+	"#version 120\n"
+	"uniform float Value;\n"
+	"uniform sampler2D Texture;\n"
+	"void main() { gl_FragColor = texture2D(Texture, vec2(Value)); }\n";
+
+/**
+ * Null backend whose programs have the uniforms of the shaders above,
+ * so uniform uploads go all the way to the dispatch table.
+ */
+class BenchDispatch : public sp::GL::NullDispatch
+{
+public:
+	virtual void GetProgramiv( GLuint program, GLenum pname, GLint* params )
+	{
+		NullDispatch::GetProgramiv(program, pname, params);
+		if(pname == GL_ACTIVE_UNIFORMS)
+			*params = 2;
+	}
+
+	virtual void GetActiveUniform( GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name )
+	{
+		NullDispatch::GetActiveUniform(program, index, bufSize, length, size, type, name);
+		std::strcpy(name, (index == 0) ? "Value" : "Texture");
+		*length = std::strlen(name);
+		*size = 1;
+		*type = (index == 0) ? GL_FLOAT : GL_SAMPLER_2D;
+	}
+
+	virtual GLint GetUniformLocation( GLuint program, const GLchar* name )
+	{
+		NullDispatch::GetUniformLocation(program, name);
+		return (std::strcmp(name, "Value") == 0) ? 0 : 1;
+	}
+};
+
+class BenchContext : public sp::GL::Context
+{
+public:
+	BenchContext() :
+		Context(new BenchDispatch())
+	{
+		postInit();
+		static_cast<BenchDispatch*>(backend())->setRecording(false);
+	}
+
+	~BenchContext()
+	{
+		shutdown();
+	}
+};
+
+/**
+ * Shaders can only be loaded from files.
+ */
+sp::StrongRef<sp::GL::Shader> CreateShader( sp::GL::Context* context, sp::GL::ShaderType type, const char* source )
+{
+	char path[] = "/tmp/sparkplug-gl-bench-XXXXXX";
+	const int fd = mkstemp(path);
+	FILE* file = (fd != -1) ? fdopen(fd, "w") : NULL;
+	if(!file)
+		sp::FatalError("Can't create a temporary shader file.");
+	fputs(source, file);
+	fclose(file);
+
+	sp::StrongRef<sp::GL::Shader> shader = sp::GL::Shader::CreateFromFile(context, type, path);
+	std::remove(path);
+	if(!shader)
+		sp::FatalError("Can't compile the benchmark shaders.");
+	return shader;
+}
+
+template<typename Function>
+void Run( sp::GL::CallCounter* counter, const char* name, int iterations, Function function )
+{
+	using namespace std::chrono;
+
+	function(0); // Warm up caches and lazily created objects
+	counter->reset();
+
+	steady_clock::time_point begin = steady_clock::now();
+	for(int i = 0; i < iterations; ++i)
+		function(i);
+	steady_clock::time_point end = steady_clock::now();
+
+	double nanoseconds = duration_cast<duration<double, std::nano> >(end-begin).count();
+	printf(
+		"{\"benchmark\": \"%s\", \"iterations\": %d, \"ns_per_op\": %.2f, \"gl_calls_per_op\": %.2f}\n",
+		name,
+		iterations,
+		nanoseconds / iterations,
+		double(counter->totalCount()) / iterations
+	);
+	fflush(stdout);
+}
+
+bool ParseOptions( int argc, char** argv, Options* options )
+{
+	options->iterations = 100000;
+	options->bufferSize = 64*1024;
+	options->image      = NULL;
+	options->headless   = false;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(i+1 < argc && std::strcmp(argv[i], "--iterations") == 0)
+			options->iterations = std::atoi(argv[++i]);
+		else if(i+1 < argc && std::strcmp(argv[i], "--buffer-size") == 0)
+			options->bufferSize = std::atoi(argv[++i]);
+		else if(i+1 < argc && std::strcmp(argv[i], "--image") == 0)
+			options->image = argv[++i];
+		else if(std::strcmp(argv[i], "--headless") == 0)
+			options->headless = true;
+		else
+			return false;
+	}
+	return options->iterations > 0 && options->bufferSize > 0;
+}
+
+int RunBenchmarks( sp::GL::Context* ctx, sp::GL::CallCounter* counter, const Options& options )
+{
+	const int n = options.iterations;
+
+	sp::StrongRef<sp::GL::VertexBuffer> vertexBuffers[2] = {
+		sp::GL::VertexBuffer::Create(ctx, sp::GL::VertexFormat::V3N3T2, 1024, sp::GL::BufferUsage_Static),
+		sp::GL::VertexBuffer::Create(ctx, sp::GL::VertexFormat::V3N3T2, 1024, sp::GL::BufferUsage_Static)
+	};
+	const sp::GL::VertexFormat formats[2] = {
+		sp::GL::VertexFormat::V3N3T2,
+		sp::GL::VertexFormat::V3T2
+	};
+	sp::StrongRef<sp::GL::Texture> textures[2] = {
+		sp::GL::Texture::Create(ctx, sp::GL::TextureType_2D),
+		sp::GL::Texture::Create(ctx, sp::GL::TextureType_2D)
+	};
+	sp::StrongRef<sp::GL::Shader> shaders[2] = {
+		CreateShader(ctx, sp::GL::ShaderType_Vertex, VertexShaderSource),
+		CreateShader(ctx, sp::GL::ShaderType_Fragment, FragmentShaderSource)
+	};
+	sp::StrongRef<sp::GL::Program> programs[2] = {
+		sp::GL::Program::Create(ctx),
+		sp::GL::Program::Create(ctx)
+	};
+	for(int i = 0; i < 2; ++i)
+	{
+		programs[i]->attach(shaders[0]);
+		programs[i]->attach(shaders[1]);
+		if(!programs[i]->linkSilent())
+			sp::FatalError("Can't link the benchmark program.");
+	}
+
+	ctx->bindProgram(programs[0]);
+	ctx->bindBuffer(vertexBuffers[0]);
+	ctx->setVertexFormat(formats[0], NULL);
+
+	Run(counter, "draw", n, [&]( int i ) {
+		ctx->draw(sp::GL::PrimitiveType_TriangleList, 0, 3);
+	});
+
+	Run(counter, "bindTexture", n, [&]( int i ) {
+		ctx->bindTexture(i % 8, textures[(i / 8) & 1]);
+		ctx->draw(sp::GL::PrimitiveType_TriangleList, 0, 3);
+	});
+
+	Run(counter, "bindTextureAuto", n, [&]( int i ) {
+		programs[0]->setUniform("Texture", ctx->bindTextureAuto(textures[i & 1]));
+		ctx->draw(sp::GL::PrimitiveType_TriangleList, 0, 3);
+	});
+
+	Run(counter, "bindProgram", n, [&]( int i ) {
+		ctx->bindProgram(programs[i & 1]);
+		ctx->draw(sp::GL::PrimitiveType_TriangleList, 0, 3);
+	});
+
+	Run(counter, "bindBuffer", n, [&]( int i ) {
+		ctx->bindBuffer(vertexBuffers[i & 1]);
+		ctx->setVertexFormat(formats[0], NULL);
+		ctx->draw(sp::GL::PrimitiveType_TriangleList, 0, 3);
+	});
+
+	Run(counter, "setVertexFormat", n, [&]( int i ) {
+		ctx->setVertexFormat(formats[i & 1], NULL);
+		ctx->draw(sp::GL::PrimitiveType_TriangleList, 0, 3);
+	});
+
+	Run(counter, "setUniform", n, [&]( int i ) {
+		programs[0]->setUniform("Value", float(i));
+	});
+
+	Run(counter, "parseVertexFormat", n, [&]( int i ) {
+		sp::GL::VertexFormat format("Position:vec3f Normal:vec3f TexCoord:vec2f Color:vec4f");
+		if(!format.isValid())
+			sp::FatalError("Invalid vertex format.");
+	});
+
+	Run(counter, "parseDataType", n, [&]( int i ) {
+		sp::GL::DataType type((i & 1) ? "vec3f" : "mat4f");
+		if(type.sizeInBytes() == 0)
+			sp::FatalError("Invalid data type.");
+	});
+
+	{
+		const int vertexSize = sp::GL::VertexFormat::V3N3T2.vertexStride();
+		const int count = options.bufferSize / vertexSize;
+		std::vector<char> data(count*vertexSize);
+		sp::StrongRef<sp::GL::VertexBuffer> buffer =
+			sp::GL::VertexBuffer::Create(ctx, sp::GL::VertexFormat::V3N3T2, count, sp::GL::BufferUsage_Stream);
+
+		Run(counter, "copyFrom", n, [&]( int i ) {
+			buffer->copyFrom(&data[0], count);
+		});
+	}
+
+	{
+		float vertices[3*3] = {0};
+
+		Run(counter, "createBuffer", n, [&]( int i ) {
+			sp::GL::VertexBuffer::Create(ctx, sp::GL::VertexFormat::V3, 3, sp::GL::BufferUsage_Dynamic)->copyFrom(vertices, 3);
+			if((i & 255) == 255)
+				ctx->endFrame();
+		});
+	}
+
+	{
+		const sp::GL::VertexFormat& format = sp::GL::VertexFormat::V3;
+		sp::StrongRef<sp::GL::StreamBuffer> stream =
+			sp::GL::StreamBuffer::Create(ctx, sp::GL::BufferTarget_Vertex, format.vertexStride(), 3*512);
+		ctx->bindBuffer(stream);
+		ctx->setVertexFormat(format, NULL);
+
+		Run(counter, "streamBuffer", n, [&]( int i ) {
+			int first = 0;
+			std::memset(stream->allocate(3, &first), 0, 3*format.vertexStride());
+			stream->commit();
+			ctx->draw(sp::GL::PrimitiveType_TriangleList, first, 3);
+			if((i & 255) == 255)
+				stream->endFrame();
+		});
+	}
+
+	if(options.image)
+	{
+		sp::Image image;
+		if(sp::ImageIo::LoadFromFile(&image, options.image, sp::ImageIo::ImageFormat_Png))
+		{
+			Run(counter, "createTextureFromImage", n, [&]( int i ) {
+				sp::GL::Texture::CreateFromImage(ctx, sp::GL::TextureType_2D, image);
+			});
+		}
+		else
+		{
+			sp::LogError("Can't load image '%s'", options.image);
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+int main( int argc, char** argv )
+{
+	Options options;
+	if(!ParseOptions(argc, argv, &options))
+	{
+		fprintf(stderr, "Usage: %s [--iterations N] [--buffer-size BYTES] [--image FILE] [--headless]\n", argv[0]);
+		return 1;
+	}
+
+	sp::GL::Context* context = NULL;
+	if(options.headless)
+		context = new sp::GL::HeadlessContext(64, 64);
+	else
+		context = new BenchContext();
+
+	sp::GL::CallCounter counter;
+	context->addInterceptor(&counter);
+	const int result = RunBenchmarks(context, &counter, options);
+	context->removeInterceptor(&counter);
+
+	delete context;
+	return result;
+}
@@ -37,25 +37,27 @@ public:
 		
 		postInit();
 		
-		glViewport(0, 0, 1024, 1024);
+		setViewport(0, 0, 1024, 1024);
 	
 		glClearColor(0.9f, 0.8f, 1.0f, 1.0f);
 		glClearDepth(1);
-		glDepthFunc(GL_LEQUAL);
-		glEnable(GL_DEPTH_TEST);
 		glPointSize(4);
 		glLineWidth(2);
 		
-		// glFrontFace(GL_CCW); // <- Ist eh default
-		// glCullFace(GL_BACK);
-	// 	glEnable(GL_CULL_FACE);
-		glDisable(GL_CULL_FACE);
+		sp::GL::DepthStencilStateDesc depthStencil;
+		depthStencil.depthTest = true;
+		depthStencil.depthFunction = sp::GL::CompareFunction_LessEqual;
+		setDepthStencilState(sp::GL::DepthStencilState::Create(this, depthStencil));
 		
-// 		glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);
+		sp::GL::RasterStateDesc raster;
+		raster.cullMode = sp::GL::CullMode_None; // CullMode_Back
+// 		raster.fillMode = sp::GL::FillMode_Point;
+		setRasterState(sp::GL::RasterState::Create(this, raster));
 	}
 	
 	~GlfwContext()
 	{
+		shutdown();
 		glfwTerminate();
 	}
 	
@@ -167,10 +169,11 @@ int main()
 		
 		program->setUniform("Time", float(sp::RuntimeInSeconds()));
 		
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+		ctx.draw(sp::GL::PrimitiveType_TriangleStrip, 0, 4);
 		
-		sp::GL::CheckGl();
+		sp::GL::CheckGl(ctx.gl());
 		
+		ctx.endFrame();
 		ctx.swapBuffers();
 		glfwPollEvents();
 		
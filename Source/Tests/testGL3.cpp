@@ -35,6 +35,7 @@ public:
 
 	~GlfwContext()
 	{
+		shutdown();
 		glfwTerminate();
 	}
 
@@ -81,6 +82,7 @@ int main()
 #undef VTX
 		glEnd();
 
+		ctx.endFrame();
 		ctx.swapBuffers();
 		glfwPollEvents();
 
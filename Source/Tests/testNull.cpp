@@ -0,0 +1,340 @@
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <cstring>
+#include <thread>
+#include <SparkPlug/Common.h>
+#include <SparkPlug/GL/NullContext.h>
+#include <SparkPlug/GL/ObjectPool.h>
+#include <SparkPlug/GL/DebugOutput.h>
+#include <SparkPlug/GL/DeletionQueue.h>
+#include <SparkPlug/GL/DrawList.h>
+#include <SparkPlug/GL/IndirectDraw.h>
+#include <SparkPlug/GL/StreamBuffer.h>
+#include <SparkPlug/GL/Texture.h>
+#include <SparkPlug/GL/Shader.h>
+#include <SparkPlug/GL/Buffer.h>
+#include <SparkPlug/GL/VertexFormat.h>
+
+namespace sp = SparkPlug;
+
+/**
+ * Runs on the null backend, so it needs neither a GPU nor a window.
+ * Each test case creates its own context.
+ */
+
+sp::StrongRef<sp::GL::VertexBuffer> CreateVertexBuffer( sp::GL::Context* context )
+{
+	return sp::GL::VertexBuffer::Create(context, sp::GL::VertexFormat::V3, 3, sp::GL::BufferUsage_Static);
+}
+
+
+TEST_CASE("GL/Dispatch/CallCounts", "Redundant binds don't reach the dispatch table")
+{
+	sp::GL::NullContext context;
+	sp::GL::NullDispatch& gl = context.nullDispatch();
+
+	sp::StrongRef<sp::GL::Program> program = sp::GL::Program::Create(&context);
+	sp::StrongRef<sp::GL::VertexBuffer> buffer = CreateVertexBuffer(&context);
+	REQUIRE(program->linkSilent());
+
+	context.bindProgram(program);
+	context.bindBuffer(buffer);
+	context.setVertexFormat(sp::GL::VertexFormat::V3, NULL);
+	gl.clearCalls();
+
+	context.draw(sp::GL::PrimitiveType_TriangleList, 0, 3);
+	CHECK(gl.callCount(sp::GL::DispatchFunction_UseProgram) == 1);
+	CHECK(gl.callCount(sp::GL::DispatchFunction_DrawArrays) == 1);
+
+	context.bindProgram(program);
+	context.draw(sp::GL::PrimitiveType_TriangleList, 0, 3);
+	CHECK(gl.callCount(sp::GL::DispatchFunction_UseProgram) == 1);
+	CHECK(gl.callCount(sp::GL::DispatchFunction_DrawArrays) == 2);
+	CHECK(context.stats().drawCalls == 2);
+
+	SECTION("GL/Dispatch/CallCounts/Arguments", "Calls record their target and object name")
+	{
+		sp::StrongRef<sp::GL::Texture> texture = sp::GL::Texture::Create(&context, sp::GL::TextureType_2D);
+		context.bindTexture(0, texture);
+		context.draw(sp::GL::PrimitiveType_TriangleList, 0, 3);
+
+		int binds = 0;
+		for(size_t i = 0; i < gl.calls().size(); ++i)
+		{
+			const sp::GL::DispatchCall& call = gl.calls()[i];
+			if(call.function != sp::GL::DispatchFunction_BindTexture)
+				continue;
+			CHECK(call.target == GL_TEXTURE_2D);
+			CHECK(call.name == texture->handle());
+			++binds;
+		}
+		CHECK(binds > 0);
+	}
+}
+
+TEST_CASE("GL/Dispatch/Supported", "The backend decides which features the context uses")
+{
+	sp::GL::NullDispatch* backend = new sp::GL::NullDispatch();
+	backend->setSupported("GL_ARB_direct_state_access", true);
+	sp::GL::NullContext context(backend);
+
+	CHECK(context.capabilities().hasFeature(sp::GL::Feature_DirectStateAccess));
+	CHECK(!context.capabilities().hasFeature(sp::GL::Feature_Sync));
+
+	backend->clearCalls();
+	sp::StrongRef<sp::GL::VertexBuffer> buffer = CreateVertexBuffer(&context);
+	CHECK(backend->callCount(sp::GL::DispatchFunction_CreateBuffers) == 1);
+	CHECK(backend->callCount(sp::GL::DispatchFunction_GenBuffersARB) == 0);
+}
+
+TEST_CASE("GL/DrawList/SortOrder", "Sorting groups equal state and keeps the submission order inside a group")
+{
+	sp::GL::NullContext context;
+
+	sp::StrongRef<sp::GL::Program> programs[2] = {
+		sp::GL::Program::Create(&context),
+		sp::GL::Program::Create(&context)
+	};
+	sp::StrongRef<sp::GL::VertexBuffer> buffer = CreateVertexBuffer(&context);
+
+	sp::GL::DrawList list;
+	for(int i = 0; i < 4; ++i)
+	{
+		sp::GL::DrawCommand command;
+		command.program = programs[(i+1) % 2];
+		command.vertexBuffer = buffer;
+		command.first = i;
+		command.count = 3;
+		list.submit(command);
+	}
+
+	REQUIRE(list.size() == 4);
+	CHECK(list.command(0).first == 0); // Submission order until sorted
+
+	list.sort();
+	for(int i = 1; i < list.size(); ++i)
+		CHECK(list.command(i-1).sortKey() <= list.command(i).sortKey());
+	CHECK(list.command(0).program == list.command(1).program);
+	CHECK(list.command(0).first < list.command(1).first);
+	CHECK(list.command(2).first < list.command(3).first);
+
+	sp::GL::NullDispatch& gl = context.nullDispatch();
+	gl.clearCalls();
+	context.execute(list);
+	CHECK(gl.callCount(sp::GL::DispatchFunction_UseProgram) == 2);
+	CHECK(gl.callCount(sp::GL::DispatchFunction_DrawArrays) == 4);
+}
+
+TEST_CASE("GL/IndirectDraw/Fallback", "Without ARB_draw_indirect the records are drawn one by one")
+{
+	sp::GL::NullContext context;
+	sp::GL::NullDispatch& gl = context.nullDispatch();
+
+	sp::StrongRef<sp::GL::Program> program = sp::GL::Program::Create(&context);
+	sp::StrongRef<sp::GL::VertexBuffer> vertexBuffer = CreateVertexBuffer(&context);
+	sp::StrongRef<sp::GL::IndexBuffer> indexBuffer = sp::GL::IndexBuffer::Create(&context, 6, sp::GL::BufferUsage_Static);
+	REQUIRE(program->linkSilent());
+
+	sp::GL::DrawCommand command;
+	command.program = program;
+	command.vertexBuffer = vertexBuffer;
+	command.indexBuffer = indexBuffer;
+	command.count = 3;
+
+	sp::GL::IndirectDrawEngine engine(&context);
+	engine.add(command);
+	command.first = 3;
+	engine.add(command);
+	REQUIRE(engine.batchCount() == 1);
+
+	gl.clearCalls();
+	engine.execute();
+	CHECK(gl.callCount(sp::GL::DispatchFunction_DrawElements) == 2);
+	CHECK(gl.callCount(sp::GL::DispatchFunction_DrawElementsIndirect) == 0);
+	CHECK(gl.callCount(sp::GL::DispatchFunction_MultiDrawElementsIndirect) == 0);
+	CHECK(gl.callCount(sp::GL::DispatchFunction_UseProgram) == 1);
+	CHECK(engine.drawCount() == 0);
+}
+
+TEST_CASE("GL/ObjectPool/Generations", "Reused slots invalidate old handles")
+{
+	sp::GL::NullContext context;
+
+	sp::StrongRef<sp::GL::VertexBuffer> buffer = CreateVertexBuffer(&context);
+	const sp::GL::Handle<sp::GL::VertexBuffer> handle(buffer);
+	REQUIRE(!handle.isNull());
+	CHECK(context.resolve(handle) == buffer.get());
+
+	buffer = NULL;
+	CHECK(context.resolve(handle) == NULL);
+
+	buffer = CreateVertexBuffer(&context);
+	const sp::GL::Handle<sp::GL::VertexBuffer> newHandle(buffer);
+	CHECK((newHandle.value() & sp::GL::ObjectPool::IndexMask) == (handle.value() & sp::GL::ObjectPool::IndexMask));
+	CHECK(newHandle != handle);
+	CHECK(context.resolve(handle) == NULL);
+	CHECK(context.resolve(newHandle) == buffer.get());
+	CHECK(context.objectPool(sp::GL::ObjectType_Buffer).size() == 1);
+
+	SECTION("GL/ObjectPool/Generations/Wrap", "Generations skip 0 when they wrap around")
+	{
+		sp::GL::ObjectPool pool;
+		sp::GL::Object* object = reinterpret_cast<sp::GL::Object*>(&pool); // Never dereferenced
+
+		unsigned int first = pool.add(object);
+		unsigned int last = first;
+		for(unsigned int i = 0; i < sp::GL::ObjectPool::GenerationMask; ++i)
+		{
+			pool.remove(last);
+			last = pool.add(object);
+			CHECK((last >> sp::GL::ObjectPool::IndexBits) != 0);
+		}
+		CHECK(last == first);
+		CHECK(pool.size() == 1);
+	}
+}
+
+TEST_CASE("GL/DebugEventQueue", "Events come out in order and a full queue refuses new ones")
+{
+	sp::GL::DebugEventQueue queue;
+	sp::GL::DebugEvent event;
+	CHECK(!queue.pop(&event));
+
+	for(int i = 0; i < sp::GL::DebugEventQueue::Capacity; ++i)
+		REQUIRE(queue.push(sp::GL::DebugEventSource_API, sp::GL::DebugEventType_Other, i, sp::GL::DebugEventSeverity_Low, "Event", -1));
+	CHECK(!queue.push(sp::GL::DebugEventSource_API, sp::GL::DebugEventType_Other, -1, sp::GL::DebugEventSeverity_Low, "Lost", -1));
+
+	for(int i = 0; i < sp::GL::DebugEventQueue::Capacity; ++i)
+	{
+		REQUIRE(queue.pop(&event));
+		CHECK(event.id == i);
+	}
+	CHECK(!queue.pop(&event));
+
+	SECTION("GL/DebugEventQueue/Truncate", "Long messages are truncated and terminated")
+	{
+		char message[sp::GL::DebugEvent::MaxMessageLength+16];
+		std::memset(message, 'x', sizeof(message));
+
+		REQUIRE(queue.push(sp::GL::DebugEventSource_API, sp::GL::DebugEventType_Error, 0, sp::GL::DebugEventSeverity_High, message, sizeof(message)));
+		REQUIRE(queue.pop(&event));
+		CHECK(std::strlen(event.message) == sp::GL::DebugEvent::MaxMessageLength-1);
+	}
+}
+
+TEST_CASE("GL/Context/AutoTextureUnits", "bindTextureAuto() evicts the least recently used unit")
+{
+	sp::GL::NullContext context;
+	context.setAutoTextureUnits(0, 2);
+
+	sp::StrongRef<sp::GL::Texture> textures[3] = {
+		sp::GL::Texture::Create(&context, sp::GL::TextureType_2D),
+		sp::GL::Texture::Create(&context, sp::GL::TextureType_2D),
+		sp::GL::Texture::Create(&context, sp::GL::TextureType_2D)
+	};
+
+	CHECK(context.bindTextureAuto(textures[0]) == 0);
+	CHECK(context.bindTextureAuto(textures[1]) == 1);
+	CHECK(context.bindTextureAuto(textures[0]) == 0); // Still bound
+	context.draw(sp::GL::PrimitiveType_TriangleList, 0, 3);
+
+	// Using unit 1 again leaves unit 0 as the least recently used one.
+	CHECK(context.bindTextureAuto(textures[1]) == 1);
+	context.draw(sp::GL::PrimitiveType_TriangleList, 0, 3);
+	CHECK(context.bindTextureAuto(textures[2]) == 0);
+	CHECK(context.stats().textureUnitEvictions == 1);
+
+	// Unit 0 is used by the next draw, so unit 1 has to go.
+	CHECK(context.bindTextureAuto(textures[0]) == 1);
+	CHECK(context.stats().textureUnitEvictions == 2);
+}
+
+TEST_CASE("GL/DeletionQueue/Batching", "Names are deleted with one call per type at the end of the frame")
+{
+	sp::GL::NullContext context;
+	sp::GL::NullDispatch& gl = context.nullDispatch();
+
+	{
+		sp::StrongRef<sp::GL::VertexBuffer> buffers[3] = {
+			CreateVertexBuffer(&context),
+			CreateVertexBuffer(&context),
+			CreateVertexBuffer(&context)
+		};
+		sp::StrongRef<sp::GL::Texture> textures[2] = {
+			sp::GL::Texture::Create(&context, sp::GL::TextureType_2D),
+			sp::GL::Texture::Create(&context, sp::GL::TextureType_2D)
+		};
+	}
+	gl.clearCalls();
+	CHECK(context.stats().objectsDeleted == 0);
+
+	// Without ARB_sync the names are deleted at the end of the frame they were queued in.
+	context.endFrame();
+	CHECK(gl.callCount(sp::GL::DispatchFunction_DeleteBuffersARB) == 1);
+	CHECK(gl.callCount(sp::GL::DispatchFunction_DeleteTextures) == 1);
+	CHECK(context.stats().objectsDeleted == 5);
+
+	SECTION("GL/DeletionQueue/Batching/Overflow", "Names are deleted early if endFrame() isn't called")
+	{
+		gl.clearCalls();
+		for(int i = 0; i < sp::GL::DeletionQueue::MaxQueuedNames; ++i)
+			CreateVertexBuffer(&context);
+		CHECK(gl.callCount(sp::GL::DispatchFunction_DeleteBuffersARB) == 0);
+
+		// The next object created on the context's thread deletes them.
+		CreateVertexBuffer(&context);
+		CHECK(gl.callCount(sp::GL::DispatchFunction_DeleteBuffersARB) == 1);
+		CHECK(context.stats().objectsDeleted == 5 + sp::GL::DeletionQueue::MaxQueuedNames);
+	}
+
+	SECTION("GL/DeletionQueue/Batching/OtherThread", "Objects released on another thread are deleted by the context's thread")
+	{
+		sp::StrongRef<sp::GL::VertexBuffer> buffer = CreateVertexBuffer(&context);
+		const GLuint name = buffer->handle();
+		const sp::GL::Handle<sp::GL::VertexBuffer> handle(buffer);
+		gl.clearCalls();
+
+		std::thread releaser([&buffer]() { buffer = NULL; });
+		releaser.join();
+		CHECK(context.resolve(handle) == NULL);
+		CHECK(gl.calls().empty());
+
+		context.endFrame();
+		REQUIRE(gl.callCount(sp::GL::DispatchFunction_DeleteBuffersARB) == 1);
+		for(size_t i = 0; i < gl.calls().size(); ++i)
+			if(gl.calls()[i].function == sp::GL::DispatchFunction_DeleteBuffersARB)
+				CHECK(gl.calls()[i].name == name);
+	}
+}
+
+TEST_CASE("GL/StreamBuffer/WrapAround", "The ring moves on every frame and orphans its storage when it wraps")
+{
+	sp::GL::NullContext context;
+	sp::GL::NullDispatch& gl = context.nullDispatch();
+
+	const int regionSize = 16;
+	const int regionCount = 3;
+	sp::StrongRef<sp::GL::StreamBuffer> stream =
+		sp::GL::StreamBuffer::Create(&context, sp::GL::BufferTarget_Vertex, sizeof(float), regionSize, regionCount);
+	REQUIRE(!stream->isPersistent()); // The null backend has no ARB_buffer_storage
+
+	int first = -1;
+	for(int frame = 0; frame < regionCount; ++frame)
+	{
+		stream->allocate(4, &first);
+		CHECK(first == frame*regionSize);
+		stream->allocate(4, &first);
+		CHECK(first == frame*regionSize + 4);
+
+		gl.clearCalls();
+		stream->endFrame();
+		CHECK(gl.callCount(sp::GL::DispatchFunction_BufferSubDataARB) == 1);
+	}
+
+	// Wrapping around orphaned the storage.
+	CHECK(gl.callCount(sp::GL::DispatchFunction_BufferDataARB) == 1);
+
+	stream->allocate(4, &first);
+	CHECK(first == 0);
+}